@@ -639,6 +639,12 @@ function(_ep_write_downloadfile_script script_filename remote local timeout no_p
   if(DEFINED CMAKE_TLS_CAINFO)
     set(tls_cainfo "set(CMAKE_TLS_CAINFO \"${CMAKE_TLS_CAINFO}\")")
   endif()
+  if(DEFINED CMAKE_DOWNLOAD_CACHE)
+    set(download_cache
+      "set(CMAKE_DOWNLOAD_CACHE \"${CMAKE_DOWNLOAD_CACHE}\")")
+  else()
+    set(download_cache "")
+  endif()
 
   # now check for curl locals so that the local values
   # will override the globals
@@ -662,6 +668,7 @@ function(_ep_write_downloadfile_script script_filename remote local timeout no_p
 
 ${tls_verify}
 ${tls_cainfo}
+${download_cache}
 
 file(DOWNLOAD
   \"${remote}\"
@@ -31,6 +31,8 @@ cmCPackArchiveGenerator::cmCPackArchiveGenerator(cmArchiveWrite::Compress t,
 {
   this->Compress = t;
   this->Archive = at;
+  this->CompressionLevel = 0;
+  this->Threads = 1;
 }
 
 //----------------------------------------------------------------------
@@ -42,8 +44,40 @@ cmCPackArchiveGenerator::~cmCPackArchiveGenerator()
 int cmCPackArchiveGenerator::InitializeInternal()
 {
   this->SetOptionIfNotSet("CPACK_INCLUDE_TOPLEVEL_DIRECTORY", "1");
+  this->CompressionLevel = 0;
+  this->Threads = 1;
+  int maxLevel = this->Compress == cmArchiveWrite::CompressZstd? 19 : 9;
+  if (!this->ReadNumberOption("CPACK_ARCHIVE_COMPRESSION_LEVEL", maxLevel,
+                              this->CompressionLevel) ||
+      !this->ReadNumberOption("CPACK_ARCHIVE_THREADS", 1024,
+                              this->Threads))
+    {
+    return 0;
+    }
   return this->Superclass::InitializeInternal();
 }
+
+//----------------------------------------------------------------------
+bool cmCPackArchiveGenerator::ReadNumberOption(const char* name,
+                                               int maximum, int& value)
+{
+  const char* option = this->GetOption(name);
+  if (!option || !*option)
+    {
+    return true;
+    }
+  std::string s = option;
+  if (s.size() > 4 || s.find_first_not_of("0123456789") != s.npos ||
+      atoi(option) > maximum)
+    {
+    cmCPackLogger(cmCPackLog::LOG_ERROR, name << " \"" << option
+                  << "\" is not a number from 0 to " << maximum << "."
+                  << std::endl);
+    return false;
+    }
+  value = atoi(option);
+  return true;
+}
 //----------------------------------------------------------------------
 int cmCPackArchiveGenerator::addOneComponentToArchive(cmArchiveWrite& archive,
                              cmCPackComponent* component)
@@ -100,7 +134,8 @@ if (!GenerateHeader(&gf)) \
             << ">." << std::endl); \
     return 0; \
   } \
-cmArchiveWrite archive(gf,this->Compress, this->Archive); \
+cmArchiveWrite archive(gf,this->Compress, this->Archive, \
+  this->CompressionLevel, this->Threads); \
 if (!archive) \
   { \
   cmCPackLogger(cmCPackLog::LOG_ERROR, "Problem to create archive < " \
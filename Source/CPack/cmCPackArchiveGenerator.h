@@ -67,6 +67,14 @@ protected:
    */
   int PackageComponentsAllInOne();
   virtual const char* GetOutputExtension() = 0;
+  /**
+   * The compression level requested by CPACK_ARCHIVE_COMPRESSION_LEVEL,
+   * or 0 for the default of the compressor, and the number of threads
+   * requested by CPACK_ARCHIVE_THREADS, or 0 for all processors.
+   */
+  int CompressionLevel;
+  int Threads;
+  bool ReadNumberOption(const char* name, int maximum, int& value);
   cmArchiveWrite::Compress Compress;
   cmArchiveWrite::Type Archive;
   };
@@ -15,6 +15,8 @@
 #include "cmMakefile.h"
 #include "cmGeneratedFileStream.h"
 #include "cmCPackLog.h"
+#include "cmArchiveWrite.h"
+#include "cmCryptoHash.h"
 
 #include <cmsys/SystemTools.hxx>
 #include <cmsys/Glob.hxx>
@@ -282,8 +284,6 @@ int cmCPackDebGenerator::PackageFiles()
 
 int cmCPackDebGenerator::createDeb()
 {
-  const char* cmakeExecutable = this->GetOption("CMAKE_COMMAND");
-
   // debian-binary file
   std::string dbfilename;
     dbfilename += this->GetOption("WDIR");
@@ -399,11 +399,6 @@ int cmCPackDebGenerator::createDeb()
     out << std::endl;
     }
 
-  std::string cmd;
-  if (NULL != this->GetOption("CPACK_DEBIAN_FAKEROOT_EXECUTABLE")) {
-      cmd += this->GetOption("CPACK_DEBIAN_FAKEROOT_EXECUTABLE");
-  }
-
   const char* debian_compression_type =
       this->GetOption("CPACK_DEBIAN_COMPRESSION_TYPE");
   if(!debian_compression_type)
@@ -411,40 +406,44 @@ int cmCPackDebGenerator::createDeb()
     debian_compression_type = "gzip";
     }
 
-  std::string cmake_tar = " ", compression_modifier = "a", compression_suffix;
+  // The bundled libarchive writes gzip and bzip2 compressed tarballs
+  // itself.  The other compression types need the tar of the system.
+  bool tar_in_process = true;
+  cmArchiveWrite::Compress tar_compression_type =
+    cmArchiveWrite::CompressGZip;
+  std::string compression_suffix;
   if(!strcmp(debian_compression_type, "lzma")) {
       compression_suffix = ".lzma";
+      tar_in_process = false;
   } else if(!strcmp(debian_compression_type, "xz")) {
       compression_suffix = ".xz";
+      tar_in_process = false;
   } else if(!strcmp(debian_compression_type, "bzip2")) {
       compression_suffix = ".bz2";
-      compression_modifier = "j";
-      cmake_tar += "\"" + std::string(cmakeExecutable) + "\" -E ";
+      tar_compression_type = cmArchiveWrite::CompressBZip2;
   } else if(!strcmp(debian_compression_type, "gzip")) {
       compression_suffix = ".gz";
-      compression_modifier = "z";
-      cmake_tar += "\"" + std::string(cmakeExecutable) + "\" -E ";
+      tar_compression_type = cmArchiveWrite::CompressGZip;
   } else if(!strcmp(debian_compression_type, "none")) {
       compression_suffix = "";
-      compression_modifier = "";
-      cmake_tar += "\"" + std::string(cmakeExecutable) + "\" -E ";
+      tar_compression_type = cmArchiveWrite::CompressNone;
   } else {
       cmCPackLogger(cmCPackLog::LOG_ERROR,
                     "Error unrecognized compression type: "
                     << debian_compression_type << std::endl);
+      return 0;
   }
 
-  cmd += cmake_tar + "tar c" + compression_modifier + "f data.tar"
-      + compression_suffix;
-
   // now add all directories which have to be compressed
   // collect all top level install dirs for that
   // e.g. /opt/bin/foo, /usr/bin/bar and /usr/bin/baz would give /usr and /opt
-    size_t topLevelLength = std::string(this->GetOption("WDIR")).length();
-    cmCPackLogger(cmCPackLog::LOG_DEBUG, "WDIR: \"" << this->GetOption("WDIR")
+  std::string wdir = this->GetOption("WDIR");
+    size_t topLevelLength = wdir.length();
+    cmCPackLogger(cmCPackLog::LOG_DEBUG, "WDIR: \"" << wdir
           << "\", length = " << topLevelLength
           << std::endl);
   std::set<std::string> installDirs;
+  std::vector<std::string> installDirList;
     for (std::vector<std::string>::const_iterator fileIt =
         packageFiles.begin();
         fileIt != packageFiles.end(); ++ fileIt )
@@ -456,74 +455,139 @@ int cmCPackDebGenerator::createDeb()
                                              slashPos - topLevelLength);
       cmCPackLogger(cmCPackLog::LOG_DEBUG, "RELATIVEDIR: \"" << relativeDir
       << "\"" << std::endl);
-    if (installDirs.find(relativeDir) == installDirs.end())
+    if (installDirs.insert(relativeDir).second)
       {
-      installDirs.insert(relativeDir);
-      cmd += " .";
-      cmd += relativeDir;
+      installDirList.push_back(relativeDir);
+      }
+    }
+
+  std::string filename_data_tar = wdir + "/data.tar" + compression_suffix;
+  if (tar_in_process)
+    {
+    // Write the tarball directly instead of running a tar process.
+    cmGeneratedFileStream fileStream_data_tar;
+    fileStream_data_tar.Open(filename_data_tar.c_str(), false, true);
+    if(!fileStream_data_tar)
+      {
+      cmCPackLogger(cmCPackLog::LOG_ERROR,
+                    "Error opening the file \"" << filename_data_tar
+                    << "\" for writing" << std::endl);
+      return 0;
+      }
+    cmArchiveWrite data_tar(fileStream_data_tar, tar_compression_type,
+                            cmArchiveWrite::TypeGNUTAR);
+
+    // Record the files as owned by root as a fakeroot tar would.
+    data_tar.SetUIDAndGID(0, 0);
+    data_tar.SetUNAMEAndGNAME("root", "root");
+
+    // debian is picky and need relative to ./ path in the tar.*
+    for (std::vector<std::string>::const_iterator dirIt =
+           installDirList.begin(); dirIt != installDirList.end(); ++dirIt)
+      {
+      if(!data_tar.Add(wdir + *dirIt, topLevelLength, "."))
+        {
+        cmCPackLogger(cmCPackLog::LOG_ERROR,
+                      "Problem adding \"" << *dirIt << "\" to \""
+                      << filename_data_tar << "\": "
+                      << data_tar.GetError() << std::endl);
+        return 0;
+        }
       }
     }
+  else
+    {
+    std::string cmd;
+    if (NULL != this->GetOption("CPACK_DEBIAN_FAKEROOT_EXECUTABLE"))
+      {
+      cmd += this->GetOption("CPACK_DEBIAN_FAKEROOT_EXECUTABLE");
+      }
+    cmd += " tar caf data.tar" + compression_suffix;
+    for (std::vector<std::string>::const_iterator dirIt =
+           installDirList.begin(); dirIt != installDirList.end(); ++dirIt)
+      {
+      cmd += " .";
+      cmd += *dirIt;
+      }
 
-  std::string output;
+    std::string output;
     int retval = -1;
-  int res = cmSystemTools::RunSingleCommand(cmd.c_str(), &output,
-      &retval, this->GetOption("WDIR"), this->GeneratorVerbose, 0);
+    int res = cmSystemTools::RunSingleCommand(cmd.c_str(), &output,
+        &retval, wdir.c_str(), this->GeneratorVerbose, 0);
 
     if ( !res || retval )
-    {
-    std::string tmpFile = this->GetOption("CPACK_TOPLEVEL_DIRECTORY");
-    tmpFile += "/Deb.log";
-    cmGeneratedFileStream ofs(tmpFile.c_str());
-    ofs << "# Run command: " << cmd << std::endl
-      << "# Working directory: " << toplevel << std::endl
-      << "# Output:" << std::endl
-      << output << std::endl;
-    cmCPackLogger(cmCPackLog::LOG_ERROR, "Problem running tar command: "
-      << cmd << std::endl
-      << "Please check " << tmpFile << " for errors" << std::endl);
-    return 0;
+      {
+      std::string tmpFile = this->GetOption("CPACK_TOPLEVEL_DIRECTORY");
+      tmpFile += "/Deb.log";
+      cmGeneratedFileStream ofs(tmpFile.c_str());
+      ofs << "# Run command: " << cmd << std::endl
+        << "# Working directory: " << toplevel << std::endl
+        << "# Output:" << std::endl
+        << output << std::endl;
+      cmCPackLogger(cmCPackLog::LOG_ERROR, "Problem running tar command: "
+        << cmd << std::endl
+        << "Please check " << tmpFile << " for errors" << std::endl);
+      return 0;
+      }
     }
 
   std::string md5filename;
-    md5filename = this->GetOption("WDIR");
+    md5filename = wdir;
   md5filename += "/md5sums";
 
     { // the scope is needed for cmGeneratedFileStream
     cmGeneratedFileStream out(md5filename.c_str());
     std::vector<std::string>::const_iterator fileIt;
-//       std::string topLevelWithTrailingSlash = toplevel;
     std::string topLevelWithTrailingSlash =
         this->GetOption("CPACK_TEMPORARY_DIRECTORY");
     topLevelWithTrailingSlash += '/';
+    cmCryptoHashMD5 md5;
       for ( fileIt = packageFiles.begin();
             fileIt != packageFiles.end(); ++ fileIt )
       {
-      cmd = "\"";
-      cmd += cmakeExecutable;
-      cmd += "\" -E md5sum \"";
-      cmd += *fileIt;
-      cmd += "\"";
-      //std::string output;
-      //int retVal = -1;
-      res = cmSystemTools::RunSingleCommand(cmd.c_str(), &output,
-          &retval, toplevel.c_str(), this->GeneratorVerbose, 0);
+      std::string output = md5.HashFile(*fileIt);
+      if(output.empty())
+        {
+        // e.g. a dangling symlink
+        cmCPackLogger(cmCPackLog::LOG_WARNING,
+                      "Cannot compute the md5sum of \"" << *fileIt
+                      << "\"" << std::endl);
+        continue;
+        }
       // debian md5sums entries are like this:
       // 014f3604694729f3bf19263bac599765  usr/bin/ccmake
       // thus strip the full path (with the trailing slash)
-      cmSystemTools::ReplaceString(output,
+      std::string file = *fileIt;
+      cmSystemTools::ReplaceString(file,
                                    topLevelWithTrailingSlash.c_str(), "");
-      out << output;
+      out << output << "  " << file << "\n";
       }
     // each line contains a eol.
     // Do not end the md5sum file with yet another (invalid)
     }
 
-    cmd = "";
-    if (NULL != this->GetOption("CPACK_DEBIAN_FAKEROOT_EXECUTABLE"))
+  std::string filename_control_tar = wdir + "/control.tar.gz";
+    {
+    // the scope is needed for cmGeneratedFileStream
+    cmGeneratedFileStream fileStream_control_tar;
+    fileStream_control_tar.Open(filename_control_tar.c_str(), false, true);
+    if(!fileStream_control_tar)
       {
-      cmd = this->GetOption("CPACK_DEBIAN_FAKEROOT_EXECUTABLE");
+      cmCPackLogger(cmCPackLog::LOG_ERROR,
+                    "Error opening the file \"" << filename_control_tar
+                    << "\" for writing" << std::endl);
+      return 0;
       }
-    cmd += cmake_tar + "tar czf control.tar.gz ./control ./md5sums";
+    cmArchiveWrite control_tar(fileStream_control_tar,
+                               cmArchiveWrite::CompressGZip,
+                               cmArchiveWrite::TypeGNUTAR);
+    control_tar.SetUIDAndGID(0, 0);
+    control_tar.SetUNAMEAndGNAME("root", "root");
+
+    // debian is picky and need relative to ./ path in the tar.*
+    std::vector<std::string> controlFiles;
+    controlFiles.push_back("control");
+    controlFiles.push_back("md5sums");
     const char* controlExtra =
       this->GetOption("CPACK_DEBIAN_PACKAGE_CONTROL_EXTRA");
   if( controlExtra )
@@ -535,50 +599,42 @@ int cmCPackDebGenerator::createDeb()
       {
       std::string filenamename =
         cmsys::SystemTools::GetFilenameName(*i);
-      std::string localcopy = this->GetOption("WDIR");
+      std::string localcopy = wdir;
       localcopy += "/";
       localcopy += filenamename;
       // if we can copy the file, it means it does exist, let's add it:
       if( cmsys::SystemTools::CopyFileIfDifferent(
             i->c_str(), localcopy.c_str()) )
         {
-        // debian is picky and need relative to ./ path in the tar.*
-        cmd += " ./";
-        cmd += filenamename;
+        controlFiles.push_back(filenamename);
         }
       }
     }
-  res = cmSystemTools::RunSingleCommand(cmd.c_str(), &output,
-      &retval, this->GetOption("WDIR"), this->GeneratorVerbose, 0);
-
-    if ( !res || retval )
-    {
-    std::string tmpFile = this->GetOption("CPACK_TOPLEVEL_DIRECTORY");
-    tmpFile += "/Deb.log";
-    cmGeneratedFileStream ofs(tmpFile.c_str());
-    ofs << "# Run command: " << cmd << std::endl
-      << "# Working directory: " << toplevel << std::endl
-      << "# Output:" << std::endl
-      << output << std::endl;
-    cmCPackLogger(cmCPackLog::LOG_ERROR, "Problem running tar command: "
-      << cmd << std::endl
-      << "Please check " << tmpFile << " for errors" << std::endl);
-    return 0;
+    for(std::vector<std::string>::const_iterator i = controlFiles.begin();
+        i != controlFiles.end(); ++i)
+      {
+      if(!control_tar.Add(wdir + "/" + *i, wdir.length() + 1, "./"))
+        {
+        cmCPackLogger(cmCPackLog::LOG_ERROR,
+                      "Problem adding \"" << *i << "\" to \""
+                      << filename_control_tar << "\": "
+                      << control_tar.GetError() << std::endl);
+        return 0;
+        }
+      }
     }
 
   // ar -r your-package-name.deb debian-binary control.tar.* data.tar.*
   // since debian packages require BSD ar (most Linux distros and even
   // FreeBSD and NetBSD ship GNU ar) we use a copy of OpenBSD ar here.
   std::vector<std::string> arFiles;
-    std::string topLevelString = this->GetOption("WDIR");
-  topLevelString += "/";
-  arFiles.push_back(topLevelString + "debian-binary");
-  arFiles.push_back(topLevelString + "control.tar.gz");
-  arFiles.push_back(topLevelString + "data.tar" + compression_suffix);
+  arFiles.push_back(dbfilename);
+  arFiles.push_back(filename_control_tar);
+  arFiles.push_back(filename_data_tar);
     std::string outputFileName = this->GetOption("CPACK_TOPLEVEL_DIRECTORY");
     outputFileName += "/";
     outputFileName += this->GetOption("CPACK_OUTPUT_FILE_NAME");
-    res = ar_append(outputFileName.c_str(), arFiles);
+    int res = ar_append(outputFileName.c_str(), arFiles);
   if ( res!=0 )
     {
     std::string tmpFile = this->GetOption("CPACK_TEMPORARY_PACKAGE_FILE_NAME");
@@ -875,6 +875,13 @@ int cmCPackGenerator::InstallProjectViaInstallCMakeProjects(
           }
         // do installation
         int res = mf->ReadListFile(0, installFile.c_str());
+        const char* bytesCopied = cm.GetProperty("INSTALL_BYTES_COPIED");
+        const char* bytesLinked = cm.GetProperty("INSTALL_BYTES_LINKED");
+        cmCPackLogger(cmCPackLog::LOG_VERBOSE,
+                      "- Install bytes copied: "
+                      << (bytesCopied? bytesCopied : "0")
+                      << ", linked: " << (bytesLinked? bytesLinked : "0")
+                      << std::endl);
         // forward definition of CMAKE_ABSOLUTE_DESTINATION_FILES
         // to CPack (may be used by generators like CPack RPM or DEB)
         // in order to transparently handle ABSOLUTE PATH
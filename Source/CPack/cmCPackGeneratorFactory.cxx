@@ -16,6 +16,7 @@
 #include "cmCPackTGZGenerator.h"
 #include "cmCPackTarBZip2Generator.h"
 #include "cmCPackTarCompressGenerator.h"
+#include "cmCPackTarZstdGenerator.h"
 #include "cmCPackZIPGenerator.h"
 #include "cmCPackSTGZGenerator.h"
 #include "cmCPackNSISGenerator.h"
@@ -103,6 +104,11 @@ cmCPackGeneratorFactory::cmCPackGeneratorFactory()
     this->RegisterGenerator("TZ", "Tar Compress compression",
       cmCPackTarCompressGenerator::CreateGenerator);
     }
+  if (cmCPackTarZstdGenerator::CanGenerate())
+    {
+    this->RegisterGenerator("TZST", "Tar Zstd compression",
+      cmCPackTarZstdGenerator::CreateGenerator);
+    }
 #ifdef __APPLE__
   if (cmCPackDragNDropGenerator::CanGenerate())
     {
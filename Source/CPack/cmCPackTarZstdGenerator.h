@@ -0,0 +1,40 @@
+/*============================================================================
+  CMake - Cross Platform Makefile Generator
+  Copyright 2014 Kitware, Inc., Insight Software Consortium
+
+  Distributed under the OSI-approved BSD License (the "License");
+  see accompanying file Copyright.txt for details.
+
+  This software is distributed WITHOUT ANY WARRANTY; without even the
+  implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+  See the License for more information.
+============================================================================*/
+
+#ifndef cmCPackTarZstdGenerator_h
+#define cmCPackTarZstdGenerator_h
+
+#include "cmCPackArchiveGenerator.h"
+
+/** \class cmCPackTarZstdGenerator
+ * \brief A generator for Tar Zstd files
+ */
+class cmCPackTarZstdGenerator : public cmCPackArchiveGenerator
+{
+public:
+  cmCPackTypeMacro(cmCPackTarZstdGenerator, cmCPackArchiveGenerator);
+  /**
+   * Construct generator
+   */
+  cmCPackTarZstdGenerator();
+  virtual ~cmCPackTarZstdGenerator();
+
+  static bool CanGenerate()
+    {
+    // The archive is compressed by the zstd tool.
+    return cmSystemTools::FindProgram("zstd") != "" ? true : false;
+    }
+protected:
+  virtual const char* GetOutputExtension() { return ".tar.zst"; }
+};
+
+#endif
@@ -205,10 +205,10 @@ void cmCTestBuildHandler::Initialize()
   this->ReallyCustomWarningExceptions.clear();
   this->ErrorWarningFileLineRegex.clear();
 
-  this->ErrorMatchRegex.clear();
-  this->ErrorExceptionRegex.clear();
-  this->WarningMatchRegex.clear();
-  this->WarningExceptionRegex.clear();
+  this->ErrorMatchRegex.Clear();
+  this->ErrorExceptionRegex.Clear();
+  this->WarningMatchRegex.Clear();
+  this->WarningExceptionRegex.Clear();
   this->BuildProcessingQueue.clear();
   this->BuildProcessingErrorQueue.clear();
   this->BuildOutputLogSize = 0;
@@ -403,14 +403,14 @@ int cmCTestBuildHandler::ProcessHandler()
   std::vector<std::string>::iterator it;
 
 #define cmCTestBuildHandlerPopulateRegexVector(strings, regexes) \
-  regexes.clear(); \
+  regexes.Clear(); \
     cmCTestLog(this->CTest, DEBUG, this << "Add " #regexes \
     << std::endl); \
   for ( it = strings.begin(); it != strings.end(); ++it ) \
     { \
     cmCTestLog(this->CTest, DEBUG, "Add " #strings ": " \
     << *it << std::endl); \
-    regexes.push_back(it->c_str()); \
+    regexes.Add(*it); \
     }
   cmCTestBuildHandlerPopulateRegexVector(
     this->CustomErrorMatches, this->ErrorMatchRegex);
@@ -861,10 +861,10 @@ void cmCTestBuildHandler::LaunchHelper::WriteLauncherConfig()
 
   // Give some testing configuration information to the launcher.
   std::string fname = this->Handler->CTestLaunchDir;
-  fname += "/CTestLaunchConfig.cmake";
+  fname += "/CTestLaunchConfig.txt";
   cmGeneratedFileStream fout(fname.c_str());
   std::string srcdir = this->CTest->GetCTestConfiguration("SourceDirectory");
-  fout << "set(CTEST_SOURCE_DIRECTORY \"" << srcdir << "\")\n";
+  fout << "SourceDirectory=" << srcdir << "\n";
 }
 
 //----------------------------------------------------------------------------
@@ -1224,8 +1224,6 @@ int cmCTestBuildHandler::ProcessSingleLine(const char* data)
 
   cmCTestLog(this->CTest, DEBUG, "Line: [" << data << "]" << std::endl);
 
-  std::vector<cmsys::RegularExpression>::iterator it;
-
   int warningLine = 0;
   int errorLine = 0;
 
@@ -1234,73 +1232,45 @@ int cmCTestBuildHandler::ProcessSingleLine(const char* data)
   if ( !this->ErrorQuotaReached )
     {
     // Errors
-    int wrxCnt = 0;
-    for ( it = this->ErrorMatchRegex.begin();
-      it != this->ErrorMatchRegex.end();
-      ++ it )
+    int wrxCnt = this->ErrorMatchRegex.Find(data);
+    if ( wrxCnt >= 0 )
       {
-      if ( it->find(data) )
-        {
-        errorLine = 1;
-        cmCTestLog(this->CTest, DEBUG, "  Error Line: " << data
-          << " (matches: " << this->CustomErrorMatches[wrxCnt] << ")"
-          << std::endl);
-        break;
-        }
-      wrxCnt ++;
+      errorLine = 1;
+      cmCTestLog(this->CTest, DEBUG, "  Error Line: " << data
+        << " (matches: " << this->CustomErrorMatches[wrxCnt] << ")"
+        << std::endl);
       }
     // Error exceptions
-    wrxCnt = 0;
-    for ( it = this->ErrorExceptionRegex.begin();
-      it != this->ErrorExceptionRegex.end();
-      ++ it )
+    wrxCnt = this->ErrorExceptionRegex.Find(data);
+    if ( wrxCnt >= 0 )
       {
-      if ( it->find(data) )
-        {
-        errorLine = 0;
-        cmCTestLog(this->CTest, DEBUG, "  Not an error Line: " << data
-          << " (matches: " << this->CustomErrorExceptions[wrxCnt] << ")"
-          << std::endl);
-        break;
-        }
-      wrxCnt ++;
+      errorLine = 0;
+      cmCTestLog(this->CTest, DEBUG, "  Not an error Line: " << data
+        << " (matches: " << this->CustomErrorExceptions[wrxCnt] << ")"
+        << std::endl);
       }
     }
   if ( !this->WarningQuotaReached )
     {
     // Warnings
-    int wrxCnt = 0;
-    for ( it = this->WarningMatchRegex.begin();
-      it != this->WarningMatchRegex.end();
-      ++ it )
+    int wrxCnt = this->WarningMatchRegex.Find(data);
+    if ( wrxCnt >= 0 )
       {
-      if ( it->find(data) )
-        {
-        warningLine = 1;
-        cmCTestLog(this->CTest, DEBUG,
-          "  Warning Line: " << data
-          << " (matches: " << this->CustomWarningMatches[wrxCnt] << ")"
-          << std::endl);
-        break;
-        }
-      wrxCnt ++;
+      warningLine = 1;
+      cmCTestLog(this->CTest, DEBUG,
+        "  Warning Line: " << data
+        << " (matches: " << this->CustomWarningMatches[wrxCnt] << ")"
+        << std::endl);
       }
 
-    wrxCnt = 0;
     // Warning exceptions
-    for ( it = this->WarningExceptionRegex.begin();
-      it != this->WarningExceptionRegex.end();
-      ++ it )
+    wrxCnt = this->WarningExceptionRegex.Find(data);
+    if ( wrxCnt >= 0 )
       {
-      if ( it->find(data) )
-        {
-        warningLine = 0;
-        cmCTestLog(this->CTest, DEBUG, "  Not a warning Line: " << data
-          << " (matches: " << this->CustomWarningExceptions[wrxCnt] << ")"
-          << std::endl);
-        break;
-        }
-      wrxCnt ++;
+      warningLine = 0;
+      cmCTestLog(this->CTest, DEBUG, "  Not a warning Line: " << data
+        << " (matches: " << this->CustomWarningExceptions[wrxCnt] << ")"
+        << std::endl);
       }
     }
   if ( errorLine )
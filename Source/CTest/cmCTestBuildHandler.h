@@ -16,6 +16,7 @@
 
 #include "cmCTestGenericHandler.h"
 #include "cmListFileCache.h"
+#include "cmCTestRegexSet.h"
 
 #include <cmsys/RegularExpression.hxx>
 
@@ -105,10 +106,10 @@ private:
   std::vector<std::string> ReallyCustomWarningExceptions;
   std::vector<cmCTestCompileErrorWarningRex> ErrorWarningFileLineRegex;
 
-  std::vector<cmsys::RegularExpression> ErrorMatchRegex;
-  std::vector<cmsys::RegularExpression> ErrorExceptionRegex;
-  std::vector<cmsys::RegularExpression> WarningMatchRegex;
-  std::vector<cmsys::RegularExpression> WarningExceptionRegex;
+  cmCTestRegexSet ErrorMatchRegex;
+  cmCTestRegexSet ErrorExceptionRegex;
+  cmCTestRegexSet WarningMatchRegex;
+  cmCTestRegexSet WarningExceptionRegex;
 
   typedef std::deque<char> t_BuildProcessingQueueType;
 
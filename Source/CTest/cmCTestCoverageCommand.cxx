@@ -27,6 +27,8 @@ cmCTestGenericHandler* cmCTestCoverageCommand::InitializeHandler()
     "CoverageCommand", "CTEST_COVERAGE_COMMAND");
   this->CTest->SetCTestConfigurationFromCMakeVariable(this->Makefile,
     "CoverageExtraFlags", "CTEST_COVERAGE_EXTRA_FLAGS");
+  this->CTest->SetCTestConfigurationFromCMakeVariable(this->Makefile,
+    "CoverageParallel", "CTEST_COVERAGE_PARALLEL");
   cmCTestCoverageHandler* handler = static_cast<cmCTestCoverageHandler*>(
     this->CTest->GetInitializedHandler("coverage"));
   if ( !handler )
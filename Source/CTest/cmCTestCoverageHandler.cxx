@@ -122,6 +122,31 @@ public:
       return this->PipeState;
     }
   int GetProcessState() { return this->PipeState;}
+  int GetExitValue()
+    {
+      return cmsysProcess_GetExitValue(this->Process);
+    }
+  int GetState()
+    {
+      return cmsysProcess_GetState(this->Process);
+    }
+  const char* GetErrorString()
+    {
+      int state = this->GetState();
+      if(state == cmsysProcess_State_Exception)
+        {
+        return cmsysProcess_GetExceptionString(this->Process);
+        }
+      else if(state == cmsysProcess_State_Error)
+        {
+        return cmsysProcess_GetErrorString(this->Process);
+        }
+      else if(state == cmsysProcess_State_Expired)
+        {
+        return "Process terminated due to timeout";
+        }
+      return "";
+    }
 private:
   int PipeState;
   cmsysProcess* Process;
@@ -557,7 +582,7 @@ int cmCTestCoverageHandler::ProcessHandler()
         }
       covLogFile << "\t\t<Line Number=\"" << cc << "\" Count=\"" << fcov[cc]
         << "\">"
-        << cmXMLSafe(line) << "</Line>" << std::endl;
+        << cmXMLSafe(line) << "</Line>\n";
       if ( fcov[cc] == 0 )
         {
         untested ++;
@@ -587,8 +612,7 @@ int cmCTestCoverageHandler::ProcessHandler()
     covLogFile << "\t\t</Report>" << std::endl
       << "\t</File>" << std::endl;
     covSumFile << "\t<File Name=\"" << cmXMLSafe(fileName)
-      << "\" FullPath=\"" << cmXMLSafe(
-        this->CTest->GetShortPathToFile(fullFileName.c_str()))
+      << "\" FullPath=\"" << cmXMLSafe(shortFileName)
       << "\" Covered=\"" << (tested+untested > 0 ? "true":"false") << "\">\n"
       << "\t\t<LOCTested>" << tested << "</LOCTested>\n"
       << "\t\t<LOCUnTested>" << untested << "</LOCUnTested>\n"
@@ -602,6 +626,11 @@ int cmCTestCoverageHandler::ProcessHandler()
     covSumFile << (cmet) << "</CoverageMetric>\n";
     this->WriteXMLLabels(covSumFile, shortFileName);
     covSumFile << "\t</File>" << std::endl;
+
+    // The line counts of this file have been written out.  Release them
+    // now rather than holding every file until the end of the run.
+    cmCTestCoverageHandlerContainer::SingleFileCoverageVector()
+      .swap(fileIterator->second);
     }
 
   //Handle all the files in the extra coverage globs that have no cov data
@@ -631,7 +660,7 @@ int cmCTestCoverageHandler::ProcessHandler()
     while (cmSystemTools::GetLineFromStream(ifs, line))
       {
       covLogFile << "\t\t<Line Number=\"" << untested << "\" Count=\"0\">"
-        << cmXMLSafe(line) << "</Line>" << std::endl;
+        << cmXMLSafe(line) << "</Line>\n";
       untested ++;
       }
     covLogFile << "\t\t</Report>\n\t</File>" << std::endl;
@@ -911,6 +940,18 @@ int cmCTestCoverageHandler::HandleJacocoCoverage(
 }
 
 
+//----------------------------------------------------------------------
+static std::string cmCTestCoverageHandlerReadOutput(std::string const& fname)
+{
+  cmsys::ifstream fin(fname.c_str(), std::ios::in | std::ios::binary);
+  cmOStringStream content;
+  if ( fin && fin.peek() != EOF )
+    {
+    content << fin.rdbuf();
+    }
+  return content.str();
+}
+
 //----------------------------------------------------------------------
 int cmCTestCoverageHandler::HandleGCovCoverage(
   cmCTestCoverageHandlerContainer* cont)
@@ -959,7 +1000,6 @@ int cmCTestCoverageHandler::HandleGCovCoverage(
 
   std::vector<std::string> files;
   this->FindGCovFiles(files);
-  std::vector<std::string>::iterator it;
 
   if ( files.size() == 0 )
     {
@@ -976,6 +1016,43 @@ int cmCTestCoverageHandler::HandleGCovCoverage(
   cmSystemTools::MakeDirectory(tempDir.c_str());
   cmSystemTools::ChangeDirectory(tempDir.c_str());
 
+  // Run up to this many gcov processes at a time.  Default to the ctest
+  // parallel level.
+  int parallelLevel = atoi(
+    this->CTest->GetCTestConfiguration("CoverageParallel").c_str());
+  if ( parallelLevel < 1 )
+    {
+    parallelLevel = this->CTest->GetParallelLevel();
+    }
+  size_t parallel = parallelLevel > 1?
+    static_cast<size_t>(parallelLevel) : 1;
+  if ( parallel > files.size() )
+    {
+    parallel = files.size();
+    }
+
+  // gcov writes its .gcov files to the working directory and names them
+  // after the sources, so concurrent jobs each need their own directory.
+  std::vector<std::string> jobDirs;
+  if ( parallel == 1 )
+    {
+    jobDirs.push_back(tempDir);
+    }
+  else
+    {
+    for ( size_t slot = 0; slot < parallel; ++slot )
+      {
+      cmOStringStream jobDir;
+      jobDir << tempDir << "/gcov" << slot;
+      jobDirs.push_back(jobDir.str());
+      cmSystemTools::MakeDirectory(jobDirs.back().c_str());
+      }
+    }
+  std::vector<cmCTestRunProcess*> jobs(parallel,
+    static_cast<cmCTestRunProcess*>(0));
+  std::vector<std::string> jobCommands(parallel);
+  size_t nextJob = 0;
+
   int gcovStyle = 0;
 
   std::set<std::string> missingFiles;
@@ -994,35 +1071,82 @@ int cmCTestCoverageHandler::HandleGCovCoverage(
   // These are binary files that you give as input to gcov so that it will
   // give us text output we can analyze to summarize coverage.
   //
-  for ( it = files.begin(); it != files.end(); ++ it )
+  for ( size_t fileIdx = 0; fileIdx < files.size(); ++fileIdx )
     {
-    cmCTestLog(this->CTest, HANDLER_OUTPUT, "." << std::flush);
+    // Keep the window of running gcov jobs full.  Results are still
+    // consumed in the order of 'files' below, so the log and the coverage
+    // totals do not depend on which job happens to finish first.
+    for ( ; nextJob < files.size() && nextJob < fileIdx + parallel;
+          ++nextJob )
+      {
+      size_t slot = nextJob % parallel;
+      std::string const& jobFile = files[nextJob];
+      std::string jobFileDir = cmSystemTools::GetFilenamePath(jobFile);
+      std::string command = "\"" + gcovCommand + "\" " +
+        gcovExtraFlags + " " +
+        "-o \"" + jobFileDir + "\" " +
+        "\"" + jobFile + "\"";
+
+      cmCTestLog(this->CTest, HANDLER_VERBOSE_OUTPUT, command.c_str()
+        << std::endl);
 
-    // Call gcov to get coverage data for this *.gcda file:
-    //
-    std::string fileDir = cmSystemTools::GetFilenamePath(*it);
-    std::string command = "\"" + gcovCommand + "\" " +
-      gcovExtraFlags + " " +
-      "-o \"" + fileDir + "\" " +
-      "\"" + *it + "\"";
+      std::vector<std::string> args =
+        cmSystemTools::ParseArguments(command.c_str());
+      cmCTestRunProcess* job = new cmCTestRunProcess;
+      for ( std::vector<std::string>::const_iterator a = args.begin();
+            a != args.end(); ++a )
+        {
+        if ( a == args.begin() )
+          {
+          job->SetCommand(a->c_str());
+          }
+        else
+          {
+          job->AddArgument(a->c_str());
+          }
+        }
+      job->SetWorkingDirectory(jobDirs[slot].c_str());
+      job->SetStdoutFile((jobDirs[slot] + "/gcov.stdout").c_str());
+      job->SetStderrFile((jobDirs[slot] + "/gcov.stderr").c_str());
+      job->StartProcess();
+      jobs[slot] = job;
+      jobCommands[slot] = command;
+      }
 
-    cmCTestLog(this->CTest, HANDLER_VERBOSE_OUTPUT, command.c_str()
-      << std::endl);
+    std::string const& file = files[fileIdx];
+    size_t slot = fileIdx % parallel;
+    std::string const& jobDir = jobDirs[slot];
+    cmCTestRunProcess* job = jobs[slot];
+    jobs[slot] = 0;
+    job->WaitForExit();
 
     std::string output = "";
     std::string errors = "";
     int retVal = 0;
-    *cont->OFS << "* Run coverage for: " << fileDir << std::endl;
-    *cont->OFS << "  Command: " << command << std::endl;
-    int res = this->CTest->RunCommand(command.c_str(), &output, &errors,
-      &retVal, tempDir.c_str(), 0 /*this->TimeOut*/);
+    bool res = job->GetState() == cmsysProcess_State_Exited;
+    if ( res )
+      {
+      retVal = job->GetExitValue();
+      output = cmCTestCoverageHandlerReadOutput(jobDir + "/gcov.stdout");
+      errors = cmCTestCoverageHandlerReadOutput(jobDir + "/gcov.stderr");
+      }
+    else
+      {
+      errors = job->GetErrorString();
+      }
+    delete job;
+
+    cmCTestLog(this->CTest, HANDLER_OUTPUT, "." << std::flush);
 
+    std::string fileDir = cmSystemTools::GetFilenamePath(file);
+    *cont->OFS << "* Run coverage for: " << fileDir << std::endl;
+    *cont->OFS << "  Command: " << jobCommands[slot] << std::endl;
     *cont->OFS << "  Output: " << output << std::endl;
     *cont->OFS << "  Errors: " << errors << std::endl;
     if ( ! res )
       {
       cmCTestLog(this->CTest, ERROR_MESSAGE,
-        "Problem running coverage on file: " << *it << std::endl);
+        "Problem running coverage on file: " << file << std::endl);
       cmCTestLog(this->CTest, ERROR_MESSAGE,
         "Command produced error: " << errors << std::endl);
       cont->Error ++;
@@ -1031,7 +1155,7 @@ int cmCTestCoverageHandler::HandleGCovCoverage(
     if ( retVal != 0 )
       {
       cmCTestLog(this->CTest, ERROR_MESSAGE, "Coverage command returned: "
-        << retVal << " while processing: " << *it << std::endl);
+        << retVal << " while processing: " << file << std::endl);
       cmCTestLog(this->CTest, ERROR_MESSAGE,
         "Command produced error: " << cont->Error << std::endl);
       }
@@ -1218,6 +1342,11 @@ int cmCTestCoverageHandler::HandleGCovCoverage(
         cmCTestLog(this->CTest, HANDLER_VERBOSE_OUTPUT, "   in gcovFile: "
           << gcovFile << std::endl);
 
+        // The job wrote its .gcov files to its own scratch directory.
+        if ( !cmSystemTools::FileIsFullPath(gcovFile.c_str()) )
+          {
+          gcovFile = jobDir + "/" + gcovFile;
+          }
         cmsys::ifstream ifile(gcovFile.c_str());
         if ( ! ifile )
           {
@@ -1258,9 +1387,9 @@ int cmCTestCoverageHandler::HandleGCovCoverage(
             int lineIdx = atoi(lineNumber.c_str())-1;
             if ( lineIdx >= 0 )
               {
-              while ( vec.size() <= static_cast<size_t>(lineIdx) )
+              if ( vec.size() <= static_cast<size_t>(lineIdx) )
                 {
-                vec.push_back(-1);
+                vec.resize(lineIdx + 1, -1);
                 }
 
               // Initially all entries are -1 (not used). If we get coverage
@@ -1345,6 +1474,16 @@ int cmCTestCoverageHandler::HandleGCovCoverage(
       }
     }
 
+  // Drop the scratch directories of the concurrent gcov jobs.
+  if ( parallel > 1 )
+    {
+    for ( std::vector<std::string>::const_iterator di = jobDirs.begin();
+          di != jobDirs.end(); ++di )
+      {
+      cmSystemTools::RemoveADirectory(di->c_str());
+      }
+    }
+
   cmSystemTools::ChangeDirectory(currentDirectory.c_str());
   return file_count;
 }
@@ -1574,9 +1713,9 @@ int cmCTestCoverageHandler::HandleLCovCoverage(
               int lineIdx = atoi(lineNumber.c_str())-1;
               if ( lineIdx >= 0 )
                 {
-                while ( vec.size() <= static_cast<size_t>(lineIdx) )
+                if ( vec.size() <= static_cast<size_t>(lineIdx) )
                   {
-                  vec.push_back(-1);
+                  vec.resize(lineIdx + 1, -1);
                   }
 
                 // Initially all entries are -1 (not used). If we get coverage
@@ -1642,6 +1781,10 @@ void cmCTestCoverageHandler::FindGCovFiles(std::vector<std::string>& files)
     gl.FindFiles(daGlob);
     files.insert(files.end(), gl.GetFiles().begin(), gl.GetFiles().end());
     }
+
+  // The order of directory entries varies between file systems.  Sort so
+  // that gcov jobs and the merge of their results follow a stable order.
+  std::sort(files.begin(), files.end());
 }
 
 //----------------------------------------------------------------------------
@@ -1782,10 +1925,9 @@ int cmCTestCoverageHandler::HandleTracePyCoverage(
         long lineIdx = cnt;
         if ( lineIdx >= 0 )
           {
-          while ( vec->size() <=
-            static_cast<size_t>(lineIdx) )
+          if ( vec->size() <= static_cast<size_t>(lineIdx) )
             {
-            vec->push_back(-1);
+            vec->resize(lineIdx + 1, -1);
             }
           // Initially all entries are -1 (not used). If we get coverage
           // information, increment it to 0 first.
@@ -27,6 +27,8 @@ cmCTestLaunch::cmCTestLaunch(int argc, const char* const* argv)
   this->Passthru = true;
   this->Process = 0;
   this->ExitCode = 1;
+  this->HaveOut = false;
+  this->HaveErr = false;
   this->CWD = cmSystemTools::GetCurrentWorkingDirectory();
 
   if(!this->ParseArguments(argc, argv))
@@ -37,8 +39,6 @@ cmCTestLaunch::cmCTestLaunch(int argc, const char* const* argv)
   this->ComputeFileNames();
 
   this->ScrapeRulesLoaded = false;
-  this->HaveOut = false;
-  this->HaveErr = false;
   this->Process = cmsysProcess_New();
 }
 
@@ -46,9 +46,12 @@ cmCTestLaunch::cmCTestLaunch(int argc, const char* const* argv)
 cmCTestLaunch::~cmCTestLaunch()
 {
   cmsysProcess_Delete(this->Process);
-  if(!this->Passthru)
+  if(this->HaveOut)
     {
     cmSystemTools::RemoveFile(this->LogOut.c_str());
+    }
+  if(this->HaveErr)
+    {
     cmSystemTools::RemoveFile(this->LogErr.c_str());
     }
 }
@@ -250,14 +253,6 @@ void cmCTestLaunch::RunChild()
     cmsysProcess_SetPipeShared(cp, cmsysProcess_Pipe_STDOUT, 1);
     cmsysProcess_SetPipeShared(cp, cmsysProcess_Pipe_STDERR, 1);
     }
-  else
-    {
-    // In full mode we record the child output pipes to log files.
-    fout.open(this->LogOut.c_str(),
-              std::ios::out | std::ios::binary);
-    ferr.open(this->LogErr.c_str(),
-              std::ios::out | std::ios::binary);
-    }
 
   // Run the real command.
   cmsysProcess_Execute(cp);
@@ -269,17 +264,29 @@ void cmCTestLaunch::RunChild()
     int length = 0;
     while(int p = cmsysProcess_WaitForData(cp, &data, &length, 0))
       {
+      // In full mode we record the child output pipes to log files.
+      // Most rules print nothing, so create the files only on demand.
       if(p == cmsysProcess_Pipe_STDOUT)
         {
+        if(!this->HaveOut)
+          {
+          fout.open(this->LogOut.c_str(),
+                    std::ios::out | std::ios::binary);
+          this->HaveOut = true;
+          }
         fout.write(data, length);
         std::cout.write(data, length);
-        this->HaveOut = true;
         }
       else if(p == cmsysProcess_Pipe_STDERR)
         {
+        if(!this->HaveErr)
+          {
+          ferr.open(this->LogErr.c_str(),
+                    std::ios::out | std::ios::binary);
+          this->HaveErr = true;
+          }
         ferr.write(data, length);
         std::cerr.write(data, length);
-        this->HaveErr = true;
         }
       }
     }
@@ -520,12 +527,18 @@ void cmCTestLaunch::WriteXMLResult(std::ostream& fxml)
 
   // StdOut
   fxml << "\t\t\t<StdOut>";
-  this->DumpFileToXML(fxml, this->LogOut);
+  if(this->HaveOut)
+    {
+    this->DumpFileToXML(fxml, this->LogOut);
+    }
   fxml << "</StdOut>\n";
 
   // StdErr
   fxml << "\t\t\t<StdErr>";
-  this->DumpFileToXML(fxml, this->LogErr);
+  if(this->HaveErr)
+    {
+    this->DumpFileToXML(fxml, this->LogErr);
+    }
   fxml << "</StdErr>\n";
 
   // ExitCondition
@@ -633,9 +646,9 @@ void cmCTestLaunch::LoadScrapeRules()
   // Common compiler warning formats.  These are much simpler than the
   // full log-scraping expressions because we do not need to extract
   // file and line information.
-  this->RegexWarning.push_back("(^|[ :])[Ww][Aa][Rr][Nn][Ii][Nn][Gg]");
-  this->RegexWarning.push_back("(^|[ :])[Rr][Ee][Mm][Aa][Rr][Kk]");
-  this->RegexWarning.push_back("(^|[ :])[Nn][Oo][Tt][Ee]");
+  this->RegexWarning.Add("(^|[ :])[Ww][Aa][Rr][Nn][Ii][Nn][Gg]");
+  this->RegexWarning.Add("(^|[ :])[Rr][Ee][Mm][Aa][Rr][Kk]");
+  this->RegexWarning.Add("(^|[ :])[Nn][Oo][Tt][Ee]");
 
   // Load custom match rules given to us by CTest.
   this->LoadScrapeRules("Warning", this->RegexWarning);
@@ -645,8 +658,7 @@ void cmCTestLaunch::LoadScrapeRules()
 //----------------------------------------------------------------------------
 void
 cmCTestLaunch
-::LoadScrapeRules(const char* purpose,
-                  std::vector<cmsys::RegularExpression>& regexps)
+::LoadScrapeRules(const char* purpose, cmCTestRegexSet& regexps)
 {
   std::string fname = this->LogDir;
   fname += "Custom";
@@ -654,13 +666,9 @@ cmCTestLaunch
   fname += ".txt";
   cmsys::ifstream fin(fname.c_str(), std::ios::in | std::ios::binary);
   std::string line;
-  cmsys::RegularExpression rex;
   while(cmSystemTools::GetLineFromStream(fin, line))
     {
-    if(rex.compile(line.c_str()))
-      {
-      regexps.push_back(rex);
-      }
+    regexps.Add(line);
     }
 }
 
@@ -691,17 +699,9 @@ bool cmCTestLaunch::ScrapeLog(std::string const& fname)
 
 //----------------------------------------------------------------------------
 bool cmCTestLaunch::Match(std::string const& line,
-                          std::vector<cmsys::RegularExpression>& regexps)
+                          cmCTestRegexSet& regexps)
 {
-  for(std::vector<cmsys::RegularExpression>::iterator ri = regexps.begin();
-      ri != regexps.end(); ++ri)
-    {
-    if(ri->find(line.c_str()))
-      {
-      return true;
-      }
-    }
-  return false;
+  return regexps.Find(line.c_str()) >= 0;
 }
 
 //----------------------------------------------------------------------------
@@ -729,24 +729,26 @@ int cmCTestLaunch::Main(int argc, const char* const argv[])
 }
 
 //----------------------------------------------------------------------------
-#include "cmGlobalGenerator.h"
-#include "cmLocalGenerator.h"
-#include "cmMakefile.h"
-#include "cmake.h"
-#include <cmsys/auto_ptr.hxx>
 void cmCTestLaunch::LoadConfig()
 {
-  cmake cm;
-  cmGlobalGenerator gg;
-  gg.SetCMakeInstance(&cm);
-  cmsys::auto_ptr<cmLocalGenerator> lg(gg.CreateLocalGenerator());
-  cmMakefile* mf = lg->GetMakefile();
+  // The configuration is written by ctest_build as "<key>=<value>" lines
+  // so that it can be loaded without running the CMake language.
   std::string fname = this->LogDir;
-  fname += "CTestLaunchConfig.cmake";
-  if(cmSystemTools::FileExists(fname.c_str()) &&
-     mf->ReadListFile(0, fname.c_str()))
+  fname += "CTestLaunchConfig.txt";
+  cmsys::ifstream fin(fname.c_str(), std::ios::in | std::ios::binary);
+  std::string line;
+  while(cmSystemTools::GetLineFromStream(fin, line))
     {
-    this->SourceDir = mf->GetSafeDefinition("CTEST_SOURCE_DIRECTORY");
-    cmSystemTools::ConvertToUnixSlashes(this->SourceDir);
+    std::string::size_type eq = line.find('=');
+    if(eq == std::string::npos)
+      {
+      continue;
+      }
+    std::string key = line.substr(0, eq);
+    if(key == "SourceDirectory")
+      {
+      this->SourceDir = line.substr(eq+1);
+      cmSystemTools::ConvertToUnixSlashes(this->SourceDir);
+      }
     }
 }
@@ -13,7 +13,7 @@
 #define cmCTestLaunch_h
 
 #include "cmStandardIncludes.h"
-#include <cmsys/RegularExpression.hxx>
+#include "cmCTestRegexSet.h"
 
 /** \class cmCTestLaunch
  * \brief Launcher for make rules to report results for ctest
@@ -80,14 +80,12 @@ private:
 
   // Regular expressions to match warnings and their exceptions.
   bool ScrapeRulesLoaded;
-  std::vector<cmsys::RegularExpression> RegexWarning;
-  std::vector<cmsys::RegularExpression> RegexWarningSuppress;
+  cmCTestRegexSet RegexWarning;
+  cmCTestRegexSet RegexWarningSuppress;
   void LoadScrapeRules();
-  void LoadScrapeRules(const char* purpose,
-                       std::vector<cmsys::RegularExpression>& regexps);
+  void LoadScrapeRules(const char* purpose, cmCTestRegexSet& regexps);
   bool ScrapeLog(std::string const& fname);
-  bool Match(std::string const& line,
-             std::vector<cmsys::RegularExpression>& regexps);
+  bool Match(std::string const& line, cmCTestRegexSet& regexps);
   bool MatchesFilterPrefix(std::string const& line) const;
 
   // Methods to generate the xml fragment.
@@ -21,6 +21,7 @@
 #include <cmsys/FStream.hxx>
 #include "cmMakefile.h"
 #include "cmXMLSafe.h"
+#include "cmCTestRegexSet.h"
 
 #include <stdlib.h>
 #include <math.h>
@@ -199,6 +200,8 @@ void cmCTestMemCheckHandler::Initialize()
   this->MemoryTesterOptions.clear();
   this->MemoryTesterStyle = UNKNOWN;
   this->MemoryTesterOutputFile = "";
+  this->TestsToPostProcess.clear();
+  this->ParsedOutputs.clear();
   int cc;
   for ( cc = 0; cc < NO_MEMORY_FAULT; cc ++ )
     {
@@ -324,6 +327,20 @@ void cmCTestMemCheckHandler::GenerateDartOutput(std::ostream& os)
       << "</Test>" << std::endl;
     }
   os << "\t</TestList>\n";
+  double processStart = cmSystemTools::GetTime();
+  // Report missing memory tester output before starting the progress line.
+  for(std::set<int>::iterator ti = this->TestsToPostProcess.begin();
+      ti != this->TestsToPostProcess.end();)
+    {
+    if(this->TestOutputFileName(*ti).empty())
+      {
+      this->TestsToPostProcess.erase(ti++);
+      }
+    else
+      {
+      ++ti;
+      }
+    }
   cmCTestLog(this->CTest, HANDLER_OUTPUT,
     "-- Processing memory checking output: ");
   size_t total = this->TestResults.size();
@@ -332,13 +349,21 @@ void cmCTestMemCheckHandler::GenerateDartOutput(std::ostream& os)
   for ( cc = 0; cc < this->TestResults.size(); cc ++ )
     {
     cmCTestTestResult *result = &this->TestResults[cc];
+    std::map<int, ParsedOutput>::iterator pi =
+      this->ParsedOutputs.find(result->TestCount);
+    if ( pi == this->ParsedOutputs.end() )
+      {
+      this->ParseTestOutput(*result);
+      pi = this->ParsedOutputs.find(result->TestCount);
+      }
     std::string memcheckstr;
-    int memcheckresults[cmCTestMemCheckHandler::NO_MEMORY_FAULT];
+    memcheckstr.swap(pi->second.Log);
+    int* memcheckresults = pi->second.Results;
     int kk;
-    bool res = this->ProcessMemCheckOutput(result->Output, memcheckstr,
-      memcheckresults);
+    bool res = pi->second.Clean;
     if ( res && result->Status == cmCTestMemCheckHandler::COMPLETED )
       {
+      this->ParsedOutputs.erase(pi);
       continue;
       }
     this->CleanTestOutput(memcheckstr,
@@ -356,6 +381,7 @@ void cmCTestMemCheckHandler::GenerateDartOutput(std::ostream& os)
         }
       this->MemoryTesterGlobalResults[kk] += memcheckresults[kk];
       }
+    this->ParsedOutputs.erase(pi);
 
     std::string logTag;
     if(this->CTest->ShouldCompressMemCheckOutput())
@@ -380,6 +406,10 @@ void cmCTestMemCheckHandler::GenerateDartOutput(std::ostream& os)
       }
     }
   cmCTestLog(this->CTest, HANDLER_OUTPUT, std::endl);
+  char processBuf[1024];
+  sprintf(processBuf, "%6.2f sec", cmSystemTools::GetTime() - processStart);
+  cmCTestLog(this->CTest, HANDLER_OUTPUT,
+    "Memory checking output processed in " << processBuf << std::endl);
   cmCTestLog(this->CTest, HANDLER_OUTPUT, "Memory checking results:"
     << std::endl);
   os << "\t<DefectList>" << std::endl;
@@ -694,37 +724,52 @@ bool cmCTestMemCheckHandler::ProcessMemCheckValgrindOutput(
 
   cmsys::RegularExpression valgrindLine("^==[0-9][0-9]*==");
 
-  cmsys::RegularExpression vgFIM(
-    "== .*Invalid free\\(\\) / delete / delete\\[\\]");
-  cmsys::RegularExpression vgFMM(
-    "== .*Mismatched free\\(\\) / delete / delete \\[\\]");
-  cmsys::RegularExpression vgMLK1(
-    "== .*[0-9,]+ bytes in [0-9,]+ blocks are definitely lost"
-   " in loss record [0-9,]+ of [0-9,]+");
-  cmsys::RegularExpression vgMLK2(
-    "== .*[0-9,]+ \\([0-9,]+ direct, [0-9,]+ indirect\\)"
-    " bytes in [0-9,]+ blocks are definitely lost"
-    " in loss record [0-9,]+ of [0-9,]+");
-  cmsys::RegularExpression vgPAR(
-    "== .*Syscall param .* (contains|points to) unaddressable byte\\(s\\)");
-  cmsys::RegularExpression vgMPK1(
-    "== .*[0-9,]+ bytes in [0-9,]+ blocks are possibly lost in"
-    " loss record [0-9,]+ of [0-9,]+");
-  cmsys::RegularExpression vgMPK2(
-    "== .*[0-9,]+ bytes in [0-9,]+ blocks are still reachable"
-    " in loss record [0-9,]+ of [0-9,]+");
-  cmsys::RegularExpression vgUMC(
-    "== .*Conditional jump or move depends on uninitialised value\\(s\\)");
-  cmsys::RegularExpression vgUMR1(
-    "== .*Use of uninitialised value of size [0-9,]+");
-  cmsys::RegularExpression vgUMR2("== .*Invalid read of size [0-9,]+");
-  cmsys::RegularExpression vgUMR3("== .*Jump to the invalid address ");
-  cmsys::RegularExpression vgUMR4("== .*Syscall param .* contains "
-    "uninitialised or unaddressable byte\\(s\\)");
-  cmsys::RegularExpression vgUMR5("== .*Syscall param .* uninitialised");
-  cmsys::RegularExpression vgIPW("== .*Invalid write of size [0-9,]+");
-  cmsys::RegularExpression vgABR("== .*pthread_mutex_unlock: mutex is "
-    "locked by a different thread");
+  // Expressions for the defects reported by valgrind, in the order in
+  // which they are tried.
+  static const struct { const char* Regex; int Failure; } vgDefects[] = {
+    {"== .*Invalid free\\(\\) / delete / delete\\[\\]",
+     cmCTestMemCheckHandler::FIM},
+    {"== .*Mismatched free\\(\\) / delete / delete \\[\\]",
+     cmCTestMemCheckHandler::FMM},
+    {"== .*[0-9,]+ bytes in [0-9,]+ blocks are definitely lost"
+     " in loss record [0-9,]+ of [0-9,]+",
+     cmCTestMemCheckHandler::MLK},
+    {"== .*[0-9,]+ \\([0-9,]+ direct, [0-9,]+ indirect\\)"
+     " bytes in [0-9,]+ blocks are definitely lost"
+     " in loss record [0-9,]+ of [0-9,]+",
+     cmCTestMemCheckHandler::MLK},
+    {"== .*Syscall param .* (contains|points to) unaddressable byte\\(s\\)",
+     cmCTestMemCheckHandler::PAR},
+    {"== .*[0-9,]+ bytes in [0-9,]+ blocks are possibly lost in"
+     " loss record [0-9,]+ of [0-9,]+",
+     cmCTestMemCheckHandler::MPK},
+    {"== .*[0-9,]+ bytes in [0-9,]+ blocks are still reachable"
+     " in loss record [0-9,]+ of [0-9,]+",
+     cmCTestMemCheckHandler::MPK},
+    {"== .*Conditional jump or move depends on uninitialised value\\(s\\)",
+     cmCTestMemCheckHandler::UMC},
+    {"== .*Use of uninitialised value of size [0-9,]+",
+     cmCTestMemCheckHandler::UMR},
+    {"== .*Invalid read of size [0-9,]+",
+     cmCTestMemCheckHandler::UMR},
+    {"== .*Jump to the invalid address ",
+     cmCTestMemCheckHandler::UMR},
+    {"== .*Syscall param .* contains "
+     "uninitialised or unaddressable byte\\(s\\)",
+     cmCTestMemCheckHandler::UMR},
+    {"== .*Syscall param .* uninitialised",
+     cmCTestMemCheckHandler::UMR},
+    {"== .*Invalid write of size [0-9,]+",
+     cmCTestMemCheckHandler::IPW},
+    {"== .*pthread_mutex_unlock: mutex is locked by a different thread",
+     cmCTestMemCheckHandler::ABR},
+    {0, 0}
+  };
+  cmCTestRegexSet vgSet;
+  for(int i = 0; vgDefects[i].Regex; ++i)
+    {
+    vgSet.Add(vgDefects[i].Regex);
+    }
   std::vector<std::string::size_type> nonValGrindOutput;
   double sttime = cmSystemTools::GetTime();
   cmCTestLog(this->CTest, DEBUG, "Start test: " << lines.size() << std::endl);
@@ -740,65 +785,10 @@ bool cmCTestMemCheckHandler::ProcessMemCheckValgrindOutput(
       cmCTestLog(this->CTest, DEBUG, "valgrind  line "
                  << lines[cc] << std::endl);
       int failure = cmCTestMemCheckHandler::NO_MEMORY_FAULT;
-      if ( vgFIM.find(lines[cc]) )
-        {
-        failure = cmCTestMemCheckHandler::FIM;
-        }
-      else if ( vgFMM.find(lines[cc]) )
-        {
-        failure = cmCTestMemCheckHandler::FMM;
-        }
-      else if ( vgMLK1.find(lines[cc]) )
-        {
-        failure = cmCTestMemCheckHandler::MLK;
-        }
-      else if ( vgMLK2.find(lines[cc]) )
-        {
-        failure = cmCTestMemCheckHandler::MLK;
-        }
-      else if ( vgPAR.find(lines[cc]) )
-        {
-        failure = cmCTestMemCheckHandler::PAR;
-        }
-      else if ( vgMPK1.find(lines[cc]) )
-        {
-        failure = cmCTestMemCheckHandler::MPK;
-        }
-      else if ( vgMPK2.find(lines[cc]) )
-        {
-        failure = cmCTestMemCheckHandler::MPK;
-        }
-      else if ( vgUMC.find(lines[cc]) )
-        {
-        failure = cmCTestMemCheckHandler::UMC;
-        }
-      else if ( vgUMR1.find(lines[cc]) )
-        {
-        failure = cmCTestMemCheckHandler::UMR;
-        }
-      else if ( vgUMR2.find(lines[cc]) )
-        {
-        failure = cmCTestMemCheckHandler::UMR;
-        }
-      else if ( vgUMR3.find(lines[cc]) )
-        {
-        failure = cmCTestMemCheckHandler::UMR;
-        }
-      else if ( vgUMR4.find(lines[cc]) )
-        {
-        failure = cmCTestMemCheckHandler::UMR;
-        }
-      else if ( vgUMR5.find(lines[cc]) )
-        {
-        failure = cmCTestMemCheckHandler::UMR;
-        }
-      else if ( vgIPW.find(lines[cc]) )
+      int found = vgSet.Find(lines[cc].c_str());
+      if ( found >= 0 )
         {
-        failure = cmCTestMemCheckHandler::IPW;
-        }
-      else if ( vgABR.find(lines[cc]) )
-        {
-        failure = cmCTestMemCheckHandler::ABR;
+        failure = vgDefects[found].Failure;
         }
 
       if ( failure != cmCTestMemCheckHandler::NO_MEMORY_FAULT )
@@ -909,6 +899,69 @@ bool cmCTestMemCheckHandler::ProcessMemCheckBoundsCheckerOutput(
   return true;
 }
 
+//----------------------------------------------------------------------
+bool cmCTestMemCheckHandler::ProcessDeferredResult()
+{
+  if ( this->TestsToPostProcess.empty() )
+    {
+    return false;
+    }
+  int test = *this->TestsToPostProcess.begin();
+  for ( TestResultsVector::iterator ri = this->TestResults.begin();
+        ri != this->TestResults.end(); ++ri )
+    {
+    if ( ri->TestCount == test )
+      {
+      this->ParseTestOutput(*ri);
+      return true;
+      }
+    }
+  this->TestsToPostProcess.erase(test);
+  return true;
+}
+
+//----------------------------------------------------------------------
+void cmCTestMemCheckHandler::ParseTestOutput(cmCTestTestResult& res)
+{
+  if ( this->TestsToPostProcess.erase(res.TestCount) )
+    {
+    this->PostProcessTest(res, res.TestCount);
+    }
+  ParsedOutput& parsed = this->ParsedOutputs[res.TestCount];
+  parsed.Clean = this->ProcessMemCheckOutput(res.Output, parsed.Log,
+                                             parsed.Results);
+  if ( parsed.Clean && res.Status == cmCTestMemCheckHandler::COMPLETED )
+    {
+    // Nothing of a clean test is written to the results.
+    parsed.Log = "";
+    }
+  // The output is not needed once parsed.
+  std::string().swap(res.Output);
+}
+
+//----------------------------------------------------------------------
+void cmCTestMemCheckHandler::PostProcessTest(cmCTestTestResult& res,
+                                             int test)
+{
+  cmCTestLog(this->CTest, HANDLER_VERBOSE_OUTPUT, test
+             << ": process test output now: "
+             << res.Name << std::endl);
+  switch ( this->MemoryTesterStyle )
+    {
+    case cmCTestMemCheckHandler::VALGRIND:
+      this->PostProcessValgrindTest(res, test);
+      break;
+    case cmCTestMemCheckHandler::PURIFY:
+      this->PostProcessPurifyTest(res, test);
+      break;
+    case cmCTestMemCheckHandler::BOUNDS_CHECKER:
+      this->PostProcessBoundsCheckerTest(res, test);
+      break;
+    default:
+      break;
+    }
+}
+
 // This method puts the bounds checker output file into the output
 // for the test
 void
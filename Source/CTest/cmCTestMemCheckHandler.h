@@ -38,6 +38,7 @@ protected:
   virtual int PreProcessHandler();
   virtual int PostProcessHandler();
   virtual void GenerateTestCommand(std::vector<std::string>& args, int test);
+  virtual bool ProcessDeferredResult();
 
 private:
 
@@ -122,6 +123,25 @@ private:
   void PostProcessBoundsCheckerTest(cmCTestTestResult& res, int test);
   void PostProcessValgrindTest(cmCTestTestResult& res, int test);
 
+  ///! Tests whose memory tester output has not been read yet.  This is
+  ///! done between checks of the running tests, after the next tests
+  ///! have been started, or when the results are written.
+  std::set<int> TestsToPostProcess;
+  void PostProcessTest(cmCTestTestResult& res, int test);
+
+  ///! Memory checking results parsed from the output of a test.
+  struct ParsedOutput
+  {
+    bool Clean;
+    std::string Log;
+    int Results[NO_MEMORY_FAULT];
+  };
+  ///! Parsed output by test index, until written to the results.
+  std::map<int, ParsedOutput> ParsedOutputs;
+  ///! Read the memory tester output of a test if that is still pending,
+  ///! parse it and release the output of the test.
+  void ParseTestOutput(cmCTestTestResult& res);
+
   ///! append MemoryTesterOutputFile to the test log
   void AppendMemTesterOutput(cmCTestTestHandler::cmCTestTestResult& res,
                              int test);
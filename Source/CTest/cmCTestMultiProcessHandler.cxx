@@ -100,10 +100,12 @@ void cmCTestMultiProcessHandler::RunTests()
       }
     this->CheckOutput();
     this->StartNextTests();
+    this->TestHandler->ProcessDeferredResult();
     }
   // let all running tests finish
   while(this->CheckOutput())
     {
+    this->TestHandler->ProcessDeferredResult();
     }
   this->MarkFinished();
   this->UpdateCostData();
@@ -0,0 +1,268 @@
+/*============================================================================
+  CMake - Cross Platform Makefile Generator
+  Copyright 2000-2009 Kitware, Inc., Insight Software Consortium
+
+  Distributed under the OSI-approved BSD License (the "License");
+  see accompanying file Copyright.txt for details.
+
+  This software is distributed WITHOUT ANY WARRANTY; without even the
+  implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+  See the License for more information.
+============================================================================*/
+#include "cmCTestRegexSet.h"
+
+#include <cmsys/stl/algorithm>
+
+//----------------------------------------------------------------------------
+static char cmCTestRegexSetLower(char c)
+{
+  return (c >= 'A' && c <= 'Z')? static_cast<char>(c - 'A' + 'a') : c;
+}
+
+//----------------------------------------------------------------------------
+// Parse a bracket expression whose opening '[' has been consumed.  If it
+// matches exactly one character up to case, store that character in
+// 'lit' and set 'single'.  Returns a pointer past the closing ']', or 0
+// if the expression is not terminated.
+static const char* cmCTestRegexSetBracket(const char* p, char& lit,
+                                          bool& single)
+{
+  // Follow the syntax accepted by cmsys::RegularExpression.
+  bool negate = false;
+  if(*p == '^')
+    {
+    negate = true;
+    ++p;
+    }
+  std::string chars;
+  if(*p == ']' || *p == '-')
+    {
+    chars += *p++;
+    }
+  while(*p && *p != ']')
+    {
+    if(*p == '-' && p[1] && p[1] != ']' && !chars.empty())
+      {
+      int first = static_cast<unsigned char>(chars[chars.size()-1]) + 1;
+      int last = static_cast<unsigned char>(p[1]);
+      for(int c = first; c <= last; ++c)
+        {
+        chars += static_cast<char>(c);
+        }
+      p += 2;
+      }
+    else
+      {
+      chars += *p++;
+      }
+    }
+  if(!*p)
+    {
+    return 0;
+    }
+
+  single = !negate && !chars.empty();
+  if(single)
+    {
+    lit = cmCTestRegexSetLower(chars[0]);
+    for(std::string::const_iterator c = chars.begin();
+        c != chars.end(); ++c)
+      {
+      if(cmCTestRegexSetLower(*c) != lit)
+        {
+        single = false;
+        break;
+        }
+      }
+    }
+  return p + 1;
+}
+
+//----------------------------------------------------------------------------
+std::string cmCTestRegexSet::RequiredLiteral(const char* regex)
+{
+  // Walk the top level of the expression collecting runs of atoms that
+  // each match one fixed character.  An atom that may be skipped or
+  // repeated ends the current run.  Any run must appear in every match,
+  // so keep the longest one.  Groups are not inspected.
+  std::string best;
+  std::string run;
+  const char* p = regex;
+  while(*p)
+    {
+    char lit = 0;
+    bool isLiteral = false;
+    switch(*p)
+      {
+      case '|':
+        // Alternation at the top level: nothing is required.
+        return "";
+      case ')': case '*': case '+': case '?':
+        // Not a valid start of an atom.
+        return "";
+      case '(':
+        {
+        int depth = 0;
+        while(*p)
+          {
+          if(*p == '\\' && p[1])
+            {
+            p += 2;
+            continue;
+            }
+          if(*p == '[')
+            {
+            bool single;
+            p = cmCTestRegexSetBracket(p+1, lit, single);
+            if(!p)
+              {
+              return "";
+              }
+            continue;
+            }
+          if(*p == '(')
+            {
+            ++depth;
+            }
+          else if(*p == ')' && --depth == 0)
+            {
+            break;
+            }
+          ++p;
+          }
+        if(!*p)
+          {
+          return "";
+          }
+        ++p;
+        }
+        break;
+      case '[':
+        p = cmCTestRegexSetBracket(p+1, lit, isLiteral);
+        if(!p)
+          {
+          return "";
+          }
+        break;
+      case '\\':
+        if(!p[1])
+          {
+          return "";
+          }
+        lit = cmCTestRegexSetLower(p[1]);
+        isLiteral = true;
+        p += 2;
+        break;
+      case '^': case '$': case '.':
+        ++p;
+        break;
+      default:
+        lit = cmCTestRegexSetLower(*p);
+        isLiteral = true;
+        ++p;
+        break;
+      }
+
+    bool optional = false;
+    bool repeated = false;
+    if(*p == '*' || *p == '?')
+      {
+      optional = true;
+      ++p;
+      }
+    else if(*p == '+')
+      {
+      repeated = true;
+      ++p;
+      }
+    if(isLiteral && !optional)
+      {
+      run += lit;
+      }
+    if(!isLiteral || optional || repeated)
+      {
+      if(run.size() > best.size())
+        {
+        best = run;
+        }
+      run = "";
+      }
+    }
+  if(run.size() > best.size())
+    {
+    best = run;
+    }
+  return best;
+}
+
+//----------------------------------------------------------------------------
+void cmCTestRegexSet::Clear()
+{
+  this->Entries.clear();
+  this->Literals.clear();
+  this->LiteralFound.clear();
+}
+
+//----------------------------------------------------------------------------
+bool cmCTestRegexSet::Add(std::string const& regex)
+{
+  Entry e;
+  e.Literal = -1;
+  bool compiled = e.Regex.compile(regex.c_str());
+  if(compiled)
+    {
+    std::string literal = cmCTestRegexSet::RequiredLiteral(regex.c_str());
+    if(!literal.empty())
+      {
+      std::vector<std::string>::iterator li =
+        std::find(this->Literals.begin(), this->Literals.end(), literal);
+      e.Literal = static_cast<int>(li - this->Literals.begin());
+      if(li == this->Literals.end())
+        {
+        this->Literals.push_back(literal);
+        this->LiteralFound.push_back(-1);
+        }
+      }
+    }
+  this->Entries.push_back(e);
+  return compiled;
+}
+
+//----------------------------------------------------------------------------
+int cmCTestRegexSet::Find(const char* line)
+{
+  bool lowered = false;
+  std::fill(this->LiteralFound.begin(), this->LiteralFound.end(), -1);
+  for(std::vector<Entry>::iterator ei = this->Entries.begin();
+      ei != this->Entries.end(); ++ei)
+    {
+    if(ei->Literal >= 0)
+      {
+      int& found = this->LiteralFound[ei->Literal];
+      if(found < 0)
+        {
+        if(!lowered)
+          {
+          this->LowerLine = line;
+          for(std::string::iterator c = this->LowerLine.begin();
+              c != this->LowerLine.end(); ++c)
+            {
+            *c = cmCTestRegexSetLower(*c);
+            }
+          lowered = true;
+          }
+        found = this->LowerLine.find(this->Literals[ei->Literal]) !=
+          std::string::npos? 1 : 0;
+        }
+      if(!found)
+        {
+        continue;
+        }
+      }
+    if(ei->Regex.find(line))
+      {
+      return static_cast<int>(ei - this->Entries.begin());
+      }
+    }
+  return -1;
+}
@@ -0,0 +1,70 @@
+/*============================================================================
+  CMake - Cross Platform Makefile Generator
+  Copyright 2000-2009 Kitware, Inc., Insight Software Consortium
+
+  Distributed under the OSI-approved BSD License (the "License");
+  see accompanying file Copyright.txt for details.
+
+  This software is distributed WITHOUT ANY WARRANTY; without even the
+  implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+  See the License for more information.
+============================================================================*/
+#ifndef cmCTestRegexSet_h
+#define cmCTestRegexSet_h
+
+#include "cmStandardIncludes.h"
+
+#include "cmLinearRegularExpression.h"
+
+/** \class cmCTestRegexSet
+ * \brief Match a line against an ordered list of regular expressions.
+ *
+ * Log scraping checks every line of build output against dozens of
+ * expressions, and most lines match none of them.  For each expression
+ * this class extracts a literal string that every match must contain.
+ * It then skips the expression on lines that do not contain that
+ * literal.  The literals are compared without regard to case.  Each
+ * distinct literal is searched for at most once per line, even when
+ * several expressions require it.  Expressions are matched with
+ * cmLinearRegularExpression so that no project-provided expression can
+ * stall the scan.
+ */
+class cmCTestRegexSet
+{
+public:
+  /** Remove all expressions.  */
+  void Clear();
+
+  /** Append an expression to the set.  An expression that does not
+      compile is kept so that indices stay aligned with the input, but
+      it never matches.  Returns whether it compiled.  */
+  bool Add(std::string const& regex);
+
+  /** Number of expressions in the set.  */
+  size_t Size() const { return this->Entries.size(); }
+
+  /** Return the index of the first expression that matches somewhere in
+      the given line, or -1 if none does.  */
+  int Find(const char* line);
+
+  /** Compute a literal that every match of the given expression must
+      contain, folded to lower case.  Returns an empty string if there
+      is no such literal.  */
+  static std::string RequiredLiteral(const char* regex);
+
+private:
+  struct Entry
+  {
+    cmLinearRegularExpression Regex;
+    int Literal;
+  };
+  std::vector<Entry> Entries;
+
+  // Distinct required literals and, while matching a line, whether each
+  // one has been found in it (-1 means not yet checked).
+  std::vector<std::string> Literals;
+  std::vector<int> LiteralFound;
+  std::string LowerLine;
+};
+
+#endif
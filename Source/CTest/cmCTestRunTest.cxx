@@ -30,6 +30,13 @@ cmCTestRunTest::cmCTestRunTest(cmCTestTestHandler* handler)
   this->TestResult.TestCount = 0;
   this->TestResult.Properties = 0;
   this->ProcessOutput = "";
+  this->ProcessOutputSize = 0;
+  this->OutputHeadSize = 0;
+  this->OutputSpillSize = 0;
+  this->OutputSpilled = false;
+  this->OutputHasFullOutputMarker = false;
+  this->OutputHasDartMeasurement = false;
+  this->Compressing = false;
   this->CompressedOutput = "";
   this->CompressionRatio = 2;
   this->StopTimePassed = false;
@@ -37,6 +44,11 @@ cmCTestRunTest::cmCTestRunTest(cmCTestTestHandler* handler)
 
 cmCTestRunTest::~cmCTestRunTest()
 {
+  if(this->Compressing)
+    {
+    (void)deflateEnd(&this->CompressionStream);
+    }
+  this->RemoveSpilledOutput();
 }
 
 //----------------------------------------------------------------------------
@@ -60,8 +72,7 @@ bool cmCTestRunTest::CheckOutput()
       // Store this line of output.
       cmCTestLog(this->CTest, HANDLER_VERBOSE_OUTPUT,
                  this->GetIndex() << ": " << line << std::endl);
-      this->ProcessOutput += line;
-      this->ProcessOutput += "\n";
+      this->AppendOutput(line);
       }
     else // if(p == cmsysProcess_Pipe_Timeout)
       {
@@ -71,78 +82,231 @@ bool cmCTestRunTest::CheckOutput()
   return true;
 }
 
-//---------------------------------------------------------
-// Streamed compression of test output.  The compressed data
-// is appended to this->CompressedOutput
-void cmCTestRunTest::CompressOutput()
+//----------------------------------------------------------------------
+void cmCTestRunTest::AppendOutput(std::string const& line)
 {
-  int ret;
-  z_stream strm;
+  if(this->Compressing)
+    {
+    this->CompressOutput(line.c_str(), line.size(), false);
+    this->CompressOutput("\n", 1, false);
+    }
+  this->ProcessOutputSize += line.size() + 1;
+
+  if(this->OutputSpilled)
+    {
+    this->SpillFile.write(line.c_str(), line.size());
+    this->SpillFile.put('\n');
+    if(line.find("CTEST_FULL_OUTPUT") != line.npos)
+      {
+      this->OutputHasFullOutputMarker = true;
+      }
+    if(line.find("<DartMeasurement") != line.npos)
+      {
+      this->OutputHasDartMeasurement = true;
+      }
+    return;
+    }
 
-  unsigned char* in =
-    reinterpret_cast<unsigned char*>(
-    const_cast<char*>(this->ProcessOutput.c_str()));
-  //zlib makes the guarantee that this is the maximum output size
-  int outSize = static_cast<int>(
-    static_cast<double>(this->ProcessOutput.size()) * 1.001 + 13.0);
-  unsigned char* out = new unsigned char[outSize];
+  this->ProcessOutput += line;
+  this->ProcessOutput += "\n";
+  if(this->OutputSpillSize == 0 ||
+     this->ProcessOutput.size() <= this->OutputSpillSize)
+    {
+    return;
+    }
 
-  strm.zalloc = Z_NULL;
-  strm.zfree = Z_NULL;
-  strm.opaque = Z_NULL;
-  ret = deflateInit(&strm, -1); //default compression level
-  if (ret != Z_OK)
+  // Move the output to a file and keep in memory only the head that
+  // may be reported after truncation.
+  this->SpillFile.open(this->SpillFileName.c_str(),
+                       std::ios::out | std::ios::binary);
+  if(!this->SpillFile)
     {
-    delete[] out;
+    cmCTestLog(this->CTest, HANDLER_VERBOSE_OUTPUT, this->Index
+               << ": Cannot create " << this->SpillFileName
+               << ", keeping test output in memory." << std::endl);
+    this->OutputSpillSize = 0;
     return;
     }
+  this->SpillFile.write(this->ProcessOutput.c_str(),
+                        this->ProcessOutput.size());
+  this->OutputHasFullOutputMarker =
+    this->ProcessOutput.find("CTEST_FULL_OUTPUT") != std::string::npos;
+  this->OutputHasDartMeasurement =
+    this->ProcessOutput.find("<DartMeasurement") != std::string::npos;
+  std::string(this->ProcessOutput, 0,
+              this->OutputHeadSize).swap(this->ProcessOutput);
+  this->OutputSpilled = true;
+}
 
-  strm.avail_in = static_cast<uInt>(this->ProcessOutput.size());
-  strm.next_in = in;
-  strm.avail_out = outSize;
-  strm.next_out = out;
-  ret = deflate(&strm, Z_FINISH);
+//----------------------------------------------------------------------
+bool cmCTestRunTest::NeedsFullOutput()
+{
+  return (this->TestHandler->MemCheck ||
+          this->TestHandler->CustomMaximumPassedTestOutputSize <= 0 ||
+          this->TestHandler->CustomMaximumFailedTestOutputSize <= 0 ||
+          !this->TestProperties->RequiredRegularExpressions.empty() ||
+          !this->TestProperties->ErrorRegularExpressions.empty() ||
+          this->OutputHasFullOutputMarker ||
+          this->OutputHasDartMeasurement);
+}
 
-  if(ret == Z_STREAM_ERROR || ret != Z_STREAM_END)
+//----------------------------------------------------------------------
+void cmCTestRunTest::LoadSpilledOutput()
+{
+  cmsys::ifstream fin(this->SpillFileName.c_str(),
+                      std::ios::in | std::ios::binary);
+  std::string output;
+  output.reserve(this->ProcessOutputSize);
+  char buffer[16384];
+  while(fin)
+    {
+    fin.read(buffer, sizeof(buffer));
+    output.append(buffer, static_cast<size_t>(fin.gcount()));
+    }
+  if(output.size() != this->ProcessOutputSize)
     {
-    cmCTestLog(this->CTest, ERROR_MESSAGE, "Error during output "
-      "compression. Sending uncompressed output." << std::endl);
-    delete[] out;
+    cmCTestLog(this->CTest, ERROR_MESSAGE, "Error reading test output from "
+               << this->SpillFileName << std::endl);
     return;
     }
+  this->ProcessOutput.swap(output);
+  this->RemoveSpilledOutput();
+}
 
-  (void)deflateEnd(&strm);
+//----------------------------------------------------------------------
+void cmCTestRunTest::RemoveSpilledOutput()
+{
+  if(this->OutputSpilled)
+    {
+    this->SpillFile.close();
+    cmSystemTools::RemoveFile(this->SpillFileName.c_str());
+    this->OutputSpilled = false;
+    }
+}
 
-  unsigned char *encoded_buffer
-    = new unsigned char[static_cast<int>(outSize * 1.5)];
+//----------------------------------------------------------------------
+void cmCTestRunTest::WriteOutput(std::ostream* os)
+{
+  if(!this->OutputSpilled)
+    {
+    if(os)
+      {
+      *os << this->ProcessOutput;
+      }
+    else
+      {
+      cmCTestLog(this->CTest, HANDLER_OUTPUT, this->ProcessOutput);
+      }
+    return;
+    }
 
-  unsigned long rlen
-    = cmsysBase64_Encode(out, strm.total_out, encoded_buffer, 1);
+  cmsys::ifstream fin(this->SpillFileName.c_str(),
+                      std::ios::in | std::ios::binary);
+  char buffer[16384];
+  while(fin)
+    {
+    fin.read(buffer, sizeof(buffer));
+    std::streamsize n = fin.gcount();
+    if(n <= 0)
+      {
+      break;
+      }
+    if(os)
+      {
+      os->write(buffer, n);
+      }
+    else
+      {
+      cmCTestLog(this->CTest, HANDLER_OUTPUT,
+                 std::string(buffer, static_cast<size_t>(n)));
+      }
+    }
+}
+
+//----------------------------------------------------------------------
+void cmCTestRunTest::StartCompression()
+{
+  z_stream& strm = this->CompressionStream;
+  strm.zalloc = Z_NULL;
+  strm.zfree = Z_NULL;
+  strm.opaque = Z_NULL;
+  //default compression level
+  this->Compressing = deflateInit(&strm, -1) == Z_OK;
+}
+
+//----------------------------------------------------------------------
+// Streamed compression of test output.  The compressed data is
+// appended to this->CompressedBytes
+void cmCTestRunTest::CompressOutput(const char* data, size_t length,
+                                    bool finish)
+{
+  z_stream& strm = this->CompressionStream;
+  strm.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(data));
+  strm.avail_in = static_cast<uInt>(length);
+  unsigned char out[16384];
+  do
+    {
+    strm.next_out = out;
+    strm.avail_out = sizeof(out);
+    if(deflate(&strm, finish? Z_FINISH : Z_NO_FLUSH) == Z_STREAM_ERROR)
+      {
+      cmCTestLog(this->CTest, ERROR_MESSAGE, "Error during output "
+        "compression. Sending uncompressed output." << std::endl);
+      (void)deflateEnd(&strm);
+      this->Compressing = false;
+      std::string().swap(this->CompressedBytes);
+      return;
+      }
+    this->CompressedBytes.append(reinterpret_cast<char*>(out),
+                                 sizeof(out) - strm.avail_out);
+    }
+  while(strm.avail_out == 0);
+}
 
-  for(unsigned long i = 0; i < rlen; i++)
+//----------------------------------------------------------------------
+void cmCTestRunTest::FinishCompression()
+{
+  if(!this->Compressing)
+    {
+    return;
+    }
+  this->CompressOutput(0, 0, true);
+  if(!this->Compressing)
     {
-    this->CompressedOutput += encoded_buffer[i];
+    return;
     }
+  z_stream& strm = this->CompressionStream;
+  (void)deflateEnd(&strm);
+  this->Compressing = false;
+
+  std::vector<unsigned char> encoded_buffer(
+    (this->CompressedBytes.size() + 2) / 3 * 4 + 1);
+  unsigned long rlen = cmsysBase64_Encode(
+    reinterpret_cast<const unsigned char*>(this->CompressedBytes.data()),
+    static_cast<unsigned long>(this->CompressedBytes.size()),
+    &encoded_buffer[0], 1);
+  this->CompressedOutput.assign(
+    reinterpret_cast<const char*>(&encoded_buffer[0]), rlen);
+  std::string().swap(this->CompressedBytes);
 
   if(strm.total_in)
     {
     this->CompressionRatio = static_cast<double>(strm.total_out) /
                              static_cast<double>(strm.total_in);
     }
-
-  delete [] encoded_buffer;
-  delete [] out;
 }
 
 //---------------------------------------------------------
 bool cmCTestRunTest::EndTest(size_t completed, size_t total, bool started)
 {
-  if ((!this->TestHandler->MemCheck &&
-      this->CTest->ShouldCompressTestOutput()) ||
-      (this->TestHandler->MemCheck &&
-      this->CTest->ShouldCompressMemCheckOutput()))
+  this->FinishCompression();
+  if(this->OutputSpilled)
     {
-    this->CompressOutput();
+    this->SpillFile.close();
+    if(this->NeedsFullOutput())
+      {
+      this->LoadSpilledOutput();
+      }
     }
 
   this->WriteLogOutputTop(completed, total);
@@ -270,7 +434,8 @@ bool cmCTestRunTest::EndTest(size_t completed, size_t total, bool started)
 
   if ( outputTestErrorsToConsole )
     {
-    cmCTestLog(this->CTest, HANDLER_OUTPUT, this->ProcessOutput << std::endl );
+    this->WriteOutput(0);
+    cmCTestLog(this->CTest, HANDLER_OUTPUT, std::endl);
     }
 
   if ( this->TestHandler->LogFile )
@@ -357,9 +522,10 @@ bool cmCTestRunTest::EndTest(size_t completed, size_t total, bool started)
     this->MemCheckPostProcess();
     this->ComputeWeightedCost();
     }
+  this->RemoveSpilledOutput();
   // Always push the current TestResult onto the
   // TestHandler vector
-  this->TestHandler->TestResults.push_back(this->TestResult);
+  this->TestHandler->RecordTestResult(this->TestResult);
   delete this->TestProcess;
   return passed;
 }
@@ -386,26 +552,11 @@ void cmCTestRunTest::MemCheckPostProcess()
     {
     return;
     }
-  cmCTestLog(this->CTest, HANDLER_VERBOSE_OUTPUT, this->Index
-             << ": process test output now: "
-             << this->TestProperties->Name << " "
-             << this->TestResult.Name << std::endl);
+  // The memory tester output is read and parsed by the scheduler once the
+  // next tests have been started.
   cmCTestMemCheckHandler * handler = static_cast<cmCTestMemCheckHandler*>
     (this->TestHandler);
-  switch ( handler->MemoryTesterStyle )
-    {
-    case cmCTestMemCheckHandler::VALGRIND:
-      handler->PostProcessValgrindTest(this->TestResult, this->Index);
-      break;
-    case cmCTestMemCheckHandler::PURIFY:
-      handler->PostProcessPurifyTest(this->TestResult, this->Index);
-      break;
-    case cmCTestMemCheckHandler::BOUNDS_CHECKER:
-      handler->PostProcessBoundsCheckerTest(this->TestResult, this->Index);
-      break;
-    default:
-      break;
-    }
+  handler->TestsToPostProcess.insert(this->Index);
 }
 
 //----------------------------------------------------------------------
@@ -499,6 +650,30 @@ bool cmCTestRunTest::StartTest(size_t total)
     {
     return false;
     }
+
+  // Output beyond the spill size goes to a file.  Keep in memory enough
+  // to truncate it as CleanTestOutput would, with room for a multi-byte
+  // character that crosses the limit.
+  int headSize = std::max(
+    this->TestHandler->CustomMaximumPassedTestOutputSize,
+    this->TestHandler->CustomMaximumFailedTestOutputSize);
+  this->OutputHeadSize = static_cast<size_t>(std::max(headSize, 0)) + 4;
+  if(this->TestHandler->CustomTestOutputSpillSize > 0)
+    {
+    this->OutputSpillSize = std::max(
+      static_cast<size_t>(this->TestHandler->CustomTestOutputSpillSize),
+      this->OutputHeadSize);
+    cmOStringStream spillName;
+    spillName << this->CTest->GetBinaryDir()
+              << "/Testing/Temporary/TestOutput." << this->Index << ".tmp";
+    this->SpillFileName = spillName.str();
+    }
+  if(!this->TestHandler->MemCheck &&
+     this->CTest->ShouldCompressTestOutput())
+    {
+    this->StartCompression();
+    }
+
   return this->ForkProcess(timeout, this->TestProperties->ExplicitTimeout,
                            &this->TestProperties->Environment);
 }
@@ -740,8 +915,8 @@ void cmCTestRunTest::WriteLogOutputTop(size_t completed, size_t total)
     << "Output:" << std::endl
     << "----------------------------------------------------------"
     << std::endl;
-  *this->TestHandler->LogFile
-    << this->ProcessOutput << "<end of output>" << std::endl;
+  this->WriteOutput(this->TestHandler->LogFile);
+  *this->TestHandler->LogFile << "<end of output>" << std::endl;
 
   cmCTestLog(this->CTest, HANDLER_OUTPUT, outname.c_str());
   cmCTestLog(this->CTest, DEBUG, "Testing "
@@ -16,6 +16,9 @@
 #include <cmCTestTestHandler.h>
 #include <cmProcess.h>
 
+#include <cm_zlib.h>
+#include <cmsys/FStream.hxx>
+
 /** \class cmRunTest
  * \brief represents a single test to be run
  *
@@ -47,9 +50,6 @@ public:
   // Read and store output.  Returns true if it must be called again.
   bool CheckOutput();
 
-  // Compresses the output, writing to CompressedOutput
-  void CompressOutput();
-
   //launch the test process, return whether it started correctly
   bool StartTest(size_t total);
   //capture and report the test results
@@ -69,6 +69,23 @@ private:
   //Run post processing of the process output for MemCheck
   void MemCheckPostProcess();
 
+  // Store a line of output, moving the output to a file once it grows
+  // beyond the spill size.
+  void AppendOutput(std::string const& line);
+  // Whether a spilled output must be loaded back in full when the test
+  // ends.
+  bool NeedsFullOutput();
+  void LoadSpilledOutput();
+  void RemoveSpilledOutput();
+  // Write the whole output, including any spilled part, to the given
+  // stream or, if none, to the console.
+  void WriteOutput(std::ostream* os);
+
+  // Compress the output as it arrives, writing to CompressedOutput
+  void StartCompression();
+  void CompressOutput(const char* data, size_t length, bool finish);
+  void FinishCompression();
+
   cmCTestTestHandler::cmCTestTestProperties * TestProperties;
   //Pointer back to the "parent"; the handler that invoked this test run
   cmCTestTestHandler * TestHandler;
@@ -82,7 +99,20 @@ private:
   bool UsePrefixCommand;
   std::string PrefixCommand;
 
+  // The whole output, or only its head once the rest has been spilled.
   std::string ProcessOutput;
+  size_t ProcessOutputSize;
+  size_t OutputHeadSize;
+  size_t OutputSpillSize;
+  std::string SpillFileName;
+  cmsys::ofstream SpillFile;
+  bool OutputSpilled;
+  bool OutputHasFullOutputMarker;
+  bool OutputHasDartMeasurement;
+
+  z_stream CompressionStream;
+  bool Compressing;
+  std::string CompressedBytes;
   std::string CompressedOutput;
   double CompressionRatio;
   //The test results
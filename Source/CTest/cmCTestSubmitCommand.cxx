@@ -153,6 +153,10 @@ cmCTestGenericHandler* cmCTestSubmitCommand::InitializeHandler()
     this->RetryCount.c_str());
   static_cast<cmCTestSubmitHandler*>(handler)->SetOption("InternalTest",
     this->InternalTest ? "ON" : "OFF");
+  static_cast<cmCTestSubmitHandler*>(handler)->SetOption("ParallelLevel",
+    this->ParallelLevel.c_str());
+  static_cast<cmCTestSubmitHandler*>(handler)->SetOption("ContentEncoding",
+    this->ContentEncoding.c_str());
 
   return handler;
 }
@@ -188,6 +192,18 @@ bool cmCTestSubmitCommand::CheckArgumentKeyword(std::string const& arg)
     return true;
     }
 
+  if(arg == "PARALLEL_LEVEL")
+    {
+    this->ArgumentDoing = ArgumentDoingParallelLevel;
+    return true;
+    }
+
+  if(arg == "CONTENT_ENCODING")
+    {
+    this->ArgumentDoing = ArgumentDoingContentEncoding;
+    return true;
+    }
+
   if(arg == "INTERNAL_TEST_CHECKSUM")
     {
     this->InternalTest = true;
@@ -250,6 +266,42 @@ bool cmCTestSubmitCommand::CheckArgumentValue(std::string const& arg)
     return true;
     }
 
+  if(this->ArgumentDoing == ArgumentDoingParallelLevel)
+    {
+    if(!arg.empty() && arg.size() <= 4 &&
+       arg.find_first_not_of("0123456789") == arg.npos &&
+       atoi(arg.c_str()) > 0)
+      {
+      this->ParallelLevel = arg;
+      }
+    else
+      {
+      cmOStringStream e;
+      e << "PARALLEL_LEVEL \"" << arg << "\" is invalid.  "
+        << "Use a positive number.";
+      this->Makefile->IssueMessage(cmake::FATAL_ERROR, e.str());
+      this->ArgumentDoing = ArgumentDoingError;
+      }
+    return true;
+    }
+
+  if(this->ArgumentDoing == ArgumentDoingContentEncoding)
+    {
+    if(arg == "gzip" || arg == "identity")
+      {
+      this->ContentEncoding = arg;
+      }
+    else
+      {
+      cmOStringStream e;
+      e << "CONTENT_ENCODING \"" << arg << "\" is invalid.  "
+        << "Use \"gzip\" or \"identity\".";
+      this->Makefile->IssueMessage(cmake::FATAL_ERROR, e.str());
+      this->ArgumentDoing = ArgumentDoingError;
+      }
+    return true;
+    }
+
   // Look for other arguments.
   return this->Superclass::CheckArgumentValue(arg);
 }
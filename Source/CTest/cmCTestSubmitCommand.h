@@ -32,6 +32,8 @@ public:
     this->InternalTest = false;
     this->RetryCount = "";
     this->RetryDelay = "";
+    this->ParallelLevel = "";
+    this->ContentEncoding = "";
     }
 
   /**
@@ -64,6 +66,8 @@ protected:
     ArgumentDoingFiles,
     ArgumentDoingRetryDelay,
     ArgumentDoingRetryCount,
+    ArgumentDoingParallelLevel,
+    ArgumentDoingContentEncoding,
     ArgumentDoingLast2
   };
 
@@ -74,6 +78,8 @@ protected:
   cmCTest::SetOfStrings Files;
   std::string RetryCount;
   std::string RetryDelay;
+  std::string ParallelLevel;
+  std::string ContentEncoding;
 };
 
 
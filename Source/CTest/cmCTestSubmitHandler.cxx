@@ -19,12 +19,14 @@
 
 #include <cmsys/Process.h>
 #include <cmsys/Base64.h>
+#include <cmsys/FStream.hxx>
 
 // For XML-RPC submission
 #include "cm_xmlrpc.h"
 
 // For curl submission
 #include "cm_curl.h"
+#include "cm_zlib.h"
 
 #include <sys/stat.h>
 
@@ -322,6 +324,86 @@ bool cmCTestSubmitHandler::SubmitUsingFTP(const std::string& localprefix,
   return true;
 }
 
+//----------------------------------------------------------------------------
+// State of one file uploaded by SubmitUsingHTTP.
+struct cmCTestSubmitHandlerUpload
+{
+  std::string LocalFile;
+  std::string URL;
+  long Size;
+  // Whether to send the file with gzip content encoding.
+  bool Gzip;
+  // The gzip-compressed content while an upload with that encoding is
+  // in progress.  It is compressed when the upload first starts and
+  // released once the upload has succeeded or failed for good.
+  std::string Body;
+  size_t BodyOffset;
+  FILE* File;
+  int Attempt;
+  double NotBefore;
+  cmCTestSubmitHandlerVectorOfChar Chunk;
+  cmCTestSubmitHandlerVectorOfChar ChunkDebug;
+  char ErrorBuffer[CURL_ERROR_SIZE];
+};
+
+//----------------------------------------------------------------------------
+static size_t
+cmCTestSubmitHandlerReadBodyCallback(void *ptr, size_t size, size_t nmemb,
+  void *data)
+{
+  cmCTestSubmitHandlerUpload* upload =
+    static_cast<cmCTestSubmitHandlerUpload*>(data);
+  size_t n = std::min(size * nmemb,
+                      upload->Body.size() - upload->BodyOffset);
+  memcpy(ptr, upload->Body.data() + upload->BodyOffset, n);
+  upload->BodyOffset += n;
+  return n;
+}
+
+//----------------------------------------------------------------------------
+static bool cmCTestSubmitHandlerGzipFile(std::string const& file,
+                                         std::string& out)
+{
+  cmsys::ifstream fin(file.c_str(), std::ios::in | std::ios::binary);
+  if(!fin)
+    {
+    return false;
+    }
+  z_stream strm;
+  strm.zalloc = Z_NULL;
+  strm.zfree = Z_NULL;
+  strm.opaque = Z_NULL;
+  // A window of 15 bits plus 16 writes a gzip header and trailer.
+  if(deflateInit2(&strm, Z_DEFAULT_COMPRESSION, Z_DEFLATED, 15 + 16, 8,
+                  Z_DEFAULT_STRATEGY) != Z_OK)
+    {
+    return false;
+    }
+  char in[16384];
+  unsigned char buffer[16384];
+  int flush;
+  int ret = Z_OK;
+  do
+    {
+    fin.read(in, sizeof(in));
+    strm.next_in = reinterpret_cast<Bytef*>(in);
+    strm.avail_in = static_cast<uInt>(fin.gcount());
+    flush = fin? Z_NO_FLUSH : Z_FINISH;
+    do
+      {
+      strm.next_out = buffer;
+      strm.avail_out = sizeof(buffer);
+      ret = deflate(&strm, flush);
+      out.append(reinterpret_cast<char*>(buffer),
+                 sizeof(buffer) - strm.avail_out);
+      }
+    while(strm.avail_out == 0 && ret != Z_STREAM_ERROR);
+    }
+  while(flush != Z_FINISH && ret != Z_STREAM_ERROR);
+  (void)deflateEnd(&strm);
+  return ret == Z_STREAM_END;
+}
+
 //----------------------------------------------------------------------------
 // Uploading files is simpler
 bool cmCTestSubmitHandler::SubmitUsingHTTP(const std::string& localprefix,
@@ -329,14 +411,6 @@ bool cmCTestSubmitHandler::SubmitUsingHTTP(const std::string& localprefix,
   const std::string& remoteprefix,
   const std::string& url)
 {
-  CURL *curl;
-  CURLcode res;
-  FILE* ftpfile;
-  char error_buffer[1024];
-
-  /* In windows, this will init the winsock stuff */
-  ::curl_global_init(CURL_GLOBAL_ALL);
-  std::string dropMethod(this->CTest->GetCTestConfiguration("DropMethod"));
   std::string curlopt(this->CTest->GetCTestConfiguration("CurlOptions"));
   std::vector<std::string> args;
   cmSystemTools::ExpandListArgument(curlopt, args);
@@ -354,277 +428,440 @@ bool cmCTestSubmitHandler::SubmitUsingHTTP(const std::string& localprefix,
       verifyHostOff = true;
       }
     }
+
+  std::string retryDelay = this->GetOption("RetryDelay") == NULL ?
+    "" : this->GetOption("RetryDelay");
+  std::string retryCount = this->GetOption("RetryCount") == NULL ?
+    "" : this->GetOption("RetryCount");
+  int delay = retryDelay == "" ? atoi(this->CTest->GetCTestConfiguration(
+    "CTestSubmitRetryDelay").c_str()) : atoi(retryDelay.c_str());
+  int count = retryCount == "" ? atoi(this->CTest->GetCTestConfiguration(
+    "CTestSubmitRetryCount").c_str()) : atoi(retryCount.c_str());
+
+  const char* parallelLevel = this->GetOption("ParallelLevel");
+  int parallel = (parallelLevel && *parallelLevel)? atoi(parallelLevel) : 1;
+  const char* contentEncoding = this->GetOption("ContentEncoding");
+  bool gzip = contentEncoding && strcmp(contentEncoding, "gzip") == 0;
+
+  bool internalTest = cmSystemTools::IsOn(this->GetOption("InternalTest"));
+  bool mockFailure = internalTest &&
+    cmSystemTools::VersionCompare(cmSystemTools::OP_LESS,
+      this->CTest->GetCDashVersion().c_str(), "1.7");
+
+  // Prepare the uploads.
+  std::vector<cmCTestSubmitHandlerUpload> uploads(files.size());
   std::string::size_type kk;
+  size_t index = 0;
   cmCTest::SetOfStrings::const_iterator file;
-  for ( file = files.begin(); file != files.end(); ++file )
+  for ( file = files.begin(); file != files.end(); ++file, ++index )
     {
-    /* get a curl handle */
-    curl = curl_easy_init();
-    if(curl)
+    cmCTestSubmitHandlerUpload& upload = uploads[index];
+    std::string local_file = *file;
+    if ( !cmSystemTools::FileExists(local_file.c_str()) )
       {
-      if(verifyPeerOff)
-        {
-        cmCTestLog(this->CTest, HANDLER_VERBOSE_OUTPUT,
-                   "  Set CURLOPT_SSL_VERIFYPEER to off\n");
-        curl_easy_setopt(curl, CURLOPT_SSL_VERIFYPEER, 0);
-        }
-      if(verifyHostOff)
-        {
-        cmCTestLog(this->CTest, HANDLER_VERBOSE_OUTPUT,
-                   "  Set CURLOPT_SSL_VERIFYHOST to off\n");
-        curl_easy_setopt(curl, CURLOPT_SSL_VERIFYHOST, 0);
-        }
+      local_file = localprefix + "/" + *file;
+      }
+    std::string remote_file
+      = remoteprefix + cmSystemTools::GetFilenameName(*file);
 
-      // Using proxy
-      if ( this->HTTPProxyType > 0 )
-        {
-        curl_easy_setopt(curl, CURLOPT_PROXY, this->HTTPProxy.c_str());
-        switch (this->HTTPProxyType)
-          {
-        case 2:
-          curl_easy_setopt(curl, CURLOPT_PROXYTYPE, CURLPROXY_SOCKS4);
-          break;
-        case 3:
-          curl_easy_setopt(curl, CURLOPT_PROXYTYPE, CURLPROXY_SOCKS5);
-          break;
-        default:
-          curl_easy_setopt(curl, CURLOPT_PROXYTYPE, CURLPROXY_HTTP);
-          if (this->HTTPProxyAuth.size() > 0)
-            {
-            curl_easy_setopt(curl, CURLOPT_PROXYUSERPWD,
-              this->HTTPProxyAuth.c_str());
-            }
-          }
-        }
-      if(this->CTest->ShouldUseHTTP10())
+    *this->LogFile << "\tUpload file: " << local_file << " to "
+        << remote_file << std::endl;
+
+    std::string ofile = "";
+    for ( kk = 0; kk < remote_file.size(); kk ++ )
+      {
+      char c = remote_file[kk];
+      char hexCh[4] = { 0, 0, 0, 0 };
+      hexCh[0] = c;
+      switch ( c )
         {
-        curl_easy_setopt(curl, CURLOPT_HTTP_VERSION, CURL_HTTP_VERSION_1_0);
+      case '+':
+      case '?':
+      case '/':
+      case '\\':
+      case '&':
+      case ' ':
+      case '=':
+      case '%':
+        sprintf(hexCh, "%%%02X", (int)c);
+        ofile.append(hexCh);
+        break;
+      default:
+        ofile.append(hexCh);
         }
-      // enable HTTP ERROR parsing
-      curl_easy_setopt(curl, CURLOPT_FAILONERROR, 1);
-      /* enable uploading */
-      curl_easy_setopt(curl, CURLOPT_UPLOAD, 1);
+      }
+    std::string upload_as
+      = url + ((url.find("?",0) == std::string::npos) ? "?" : "&")
+      + "FileName=" + ofile;
 
-      // if there is little to no activity for too long stop submitting
-      ::curl_easy_setopt(curl, CURLOPT_LOW_SPEED_LIMIT, 1);
-      ::curl_easy_setopt(curl, CURLOPT_LOW_SPEED_TIME,
-        SUBMIT_TIMEOUT_IN_SECONDS_DEFAULT);
+    upload_as += "&MD5=";
 
-      /* HTTP PUT please */
-      ::curl_easy_setopt(curl, CURLOPT_PUT, 1);
-      ::curl_easy_setopt(curl, CURLOPT_VERBOSE, 1);
+    if(internalTest)
+      {
+      upload_as += "bad_md5sum";
+      }
+    else
+      {
+      char md5[33];
+      cmSystemTools::ComputeFileMD5(local_file, md5);
+      md5[32] = 0;
+      upload_as += md5;
+      }
 
-      std::string local_file = *file;
-      if ( !cmSystemTools::FileExists(local_file.c_str()) )
-        {
-        local_file = localprefix + "/" + *file;
-        }
-      std::string remote_file
-        = remoteprefix + cmSystemTools::GetFilenameName(*file);
+    struct stat st;
+    if ( ::stat(local_file.c_str(), &st) )
+      {
+      cmCTestLog(this->CTest, ERROR_MESSAGE, "   Cannot find file: "
+        << local_file << std::endl);
+      return false;
+      }
 
-      *this->LogFile << "\tUpload file: " << local_file << " to "
-          << remote_file << std::endl;
+    upload.LocalFile = local_file;
+    upload.URL = upload_as;
+    upload.Size = static_cast<long>(st.st_size);
+    // Files that are already compressed are sent as they are.
+    upload.Gzip = gzip &&
+      !cmSystemTools::StringEndsWith(local_file.c_str(), ".gz");
+    upload.BodyOffset = 0;
+    upload.File = 0;
+    upload.Attempt = 0;
+    upload.NotBefore = 0;
+    upload.ErrorBuffer[0] = 0;
+    }
 
-      std::string ofile = "";
-      for ( kk = 0; kk < remote_file.size(); kk ++ )
+  if(parallel < 1)
+    {
+    parallel = 1;
+    }
+  if(static_cast<size_t>(parallel) > uploads.size())
+    {
+    parallel = static_cast<int>(uploads.size());
+    }
+
+  /* In windows, this will init the winsock stuff */
+  ::curl_global_init(CURL_GLOBAL_ALL);
+  CURLM* multi = ::curl_multi_init();
+  if(!multi)
+    {
+    cmCTestLog(this->CTest, ERROR_MESSAGE,
+      "   Cannot initialize the curl multi interface" << std::endl);
+    ::curl_global_cleanup();
+    return false;
+    }
+
+  // Create one handle per concurrent upload.  Each handle is reused for
+  // later files, and the multi handle shares its connections.
+  std::vector<CURL*> handles;
+  std::vector<CURL*> idle;
+  for(int i = 0; i < parallel; ++i)
+    {
+    CURL* curl = ::curl_easy_init();
+    if(!curl)
+      {
+      break;
+      }
+    handles.push_back(curl);
+    idle.push_back(curl);
+    if(verifyPeerOff)
+      {
+      cmCTestLog(this->CTest, HANDLER_VERBOSE_OUTPUT,
+                 "  Set CURLOPT_SSL_VERIFYPEER to off\n");
+      curl_easy_setopt(curl, CURLOPT_SSL_VERIFYPEER, 0);
+      }
+    if(verifyHostOff)
+      {
+      cmCTestLog(this->CTest, HANDLER_VERBOSE_OUTPUT,
+                 "  Set CURLOPT_SSL_VERIFYHOST to off\n");
+      curl_easy_setopt(curl, CURLOPT_SSL_VERIFYHOST, 0);
+      }
+
+    // Using proxy
+    if ( this->HTTPProxyType > 0 )
+      {
+      curl_easy_setopt(curl, CURLOPT_PROXY, this->HTTPProxy.c_str());
+      switch (this->HTTPProxyType)
         {
-        char c = remote_file[kk];
-        char hexCh[4] = { 0, 0, 0, 0 };
-        hexCh[0] = c;
-        switch ( c )
+      case 2:
+        curl_easy_setopt(curl, CURLOPT_PROXYTYPE, CURLPROXY_SOCKS4);
+        break;
+      case 3:
+        curl_easy_setopt(curl, CURLOPT_PROXYTYPE, CURLPROXY_SOCKS5);
+        break;
+      default:
+        curl_easy_setopt(curl, CURLOPT_PROXYTYPE, CURLPROXY_HTTP);
+        if (this->HTTPProxyAuth.size() > 0)
           {
-        case '+':
-        case '?':
-        case '/':
-        case '\\':
-        case '&':
-        case ' ':
-        case '=':
-        case '%':
-          sprintf(hexCh, "%%%02X", (int)c);
-          ofile.append(hexCh);
-          break;
-        default:
-          ofile.append(hexCh);
+          curl_easy_setopt(curl, CURLOPT_PROXYUSERPWD,
+            this->HTTPProxyAuth.c_str());
           }
         }
-      std::string upload_as
-        = url + ((url.find("?",0) == std::string::npos) ? "?" : "&")
-        + "FileName=" + ofile;
-
-      upload_as += "&MD5=";
+      }
+    if(this->CTest->ShouldUseHTTP10())
+      {
+      curl_easy_setopt(curl, CURLOPT_HTTP_VERSION, CURL_HTTP_VERSION_1_0);
+      }
+    // enable HTTP ERROR parsing
+    curl_easy_setopt(curl, CURLOPT_FAILONERROR, 1);
+    /* enable uploading */
+    curl_easy_setopt(curl, CURLOPT_UPLOAD, 1);
+
+    // if there is little to no activity for too long stop submitting
+    ::curl_easy_setopt(curl, CURLOPT_LOW_SPEED_LIMIT, 1);
+    ::curl_easy_setopt(curl, CURLOPT_LOW_SPEED_TIME,
+      SUBMIT_TIMEOUT_IN_SECONDS_DEFAULT);
+
+    /* HTTP PUT please */
+    ::curl_easy_setopt(curl, CURLOPT_PUT, 1);
+    ::curl_easy_setopt(curl, CURLOPT_VERBOSE, 1);
+
+    // specify handler for output
+    ::curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION,
+      cmCTestSubmitHandlerWriteMemoryCallback);
+    ::curl_easy_setopt(curl, CURLOPT_DEBUGFUNCTION,
+      cmCTestSubmitHandlerCurlDebugCallback);
+    }
+  struct curl_slist* gzipHeaders =
+    ::curl_slist_append(0, "Content-Encoding: gzip");
 
-      if(cmSystemTools::IsOn(this->GetOption("InternalTest")))
+  // Uploads wait in order until a handle is free and any retry delay
+  // has passed.  Each one runs on the handle stored at its index.
+  std::deque<size_t> pending;
+  for(index = 0; index < uploads.size(); ++index)
+    {
+    pending.push_back(index);
+    }
+  std::map<CURL*, size_t> running;
+  bool success = !handles.empty();
+  while(success && (!pending.empty() || !running.empty()))
+    {
+    // Start the uploads that are ready.
+    double now = cmSystemTools::GetTime();
+    for(std::deque<size_t>::iterator pi = pending.begin();
+        pi != pending.end() && !idle.empty();)
+      {
+      cmCTestSubmitHandlerUpload& upload = uploads[*pi];
+      if(upload.NotBefore > now)
         {
-        upload_as += "bad_md5sum";
+        ++pi;
+        continue;
         }
-      else
+
+      // Compress only when the upload starts so that at most the running
+      // uploads hold a compressed copy in memory.  Retries reuse it.
+      if(upload.Gzip && upload.Body.empty() &&
+         !cmCTestSubmitHandlerGzipFile(upload.LocalFile, upload.Body))
         {
-        char md5[33];
-        cmSystemTools::ComputeFileMD5(local_file, md5);
-        md5[32] = 0;
-        upload_as += md5;
+        cmCTestLog(this->CTest, ERROR_MESSAGE, "   Cannot compress file: "
+          << upload.LocalFile << std::endl);
+        success = false;
+        break;
         }
 
-      struct stat st;
-      if ( ::stat(local_file.c_str(), &st) )
+      CURL* curl = idle.back();
+      idle.pop_back();
+      running[curl] = *pi;
+      pi = pending.erase(pi);
+
+      if(upload.Attempt == 0)
         {
-        cmCTestLog(this->CTest, ERROR_MESSAGE, "   Cannot find file: "
-          << local_file << std::endl);
-        ::curl_easy_cleanup(curl);
-        ::curl_global_cleanup();
-        return false;
+        cmCTestLog(this->CTest, HANDLER_VERBOSE_OUTPUT, "   Upload file: "
+          << upload.LocalFile << " to "
+          << upload.URL << " Size: " << upload.Size << std::endl);
         }
-
-      ftpfile = cmsys::SystemTools::Fopen(local_file.c_str(), "rb");
-      cmCTestLog(this->CTest, HANDLER_VERBOSE_OUTPUT, "   Upload file: "
-        << local_file << " to "
-        << upload_as << " Size: " << st.st_size << std::endl);
+      upload.Chunk.clear();
+      upload.ChunkDebug.clear();
 
       // specify target
-      ::curl_easy_setopt(curl,CURLOPT_URL, upload_as.c_str());
-
-      // now specify which file to upload
-      ::curl_easy_setopt(curl, CURLOPT_INFILE, ftpfile);
+      ::curl_easy_setopt(curl,CURLOPT_URL, upload.URL.c_str());
 
-      // and give the size of the upload (optional)
-      ::curl_easy_setopt(curl, CURLOPT_INFILESIZE,
-        static_cast<long>(st.st_size));
+      // now specify which file to upload and give the size of the upload
+      if(!upload.Gzip)
+        {
+        upload.File = cmsys::SystemTools::Fopen(upload.LocalFile.c_str(),
+                                                "rb");
+        ::curl_easy_setopt(curl, CURLOPT_READFUNCTION, 0);
+        ::curl_easy_setopt(curl, CURLOPT_INFILE, upload.File);
+        ::curl_easy_setopt(curl, CURLOPT_INFILESIZE, upload.Size);
+        ::curl_easy_setopt(curl, CURLOPT_HTTPHEADER, 0);
+        }
+      else
+        {
+        upload.BodyOffset = 0;
+        ::curl_easy_setopt(curl, CURLOPT_READFUNCTION,
+          cmCTestSubmitHandlerReadBodyCallback);
+        ::curl_easy_setopt(curl, CURLOPT_INFILE, &upload);
+        ::curl_easy_setopt(curl, CURLOPT_INFILESIZE,
+          static_cast<long>(upload.Body.size()));
+        ::curl_easy_setopt(curl, CURLOPT_HTTPHEADER, gzipHeaders);
+        }
 
       // and give curl the buffer for errors
-      ::curl_easy_setopt(curl, CURLOPT_ERRORBUFFER, &error_buffer);
-
-      // specify handler for output
-      ::curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION,
-        cmCTestSubmitHandlerWriteMemoryCallback);
-      ::curl_easy_setopt(curl, CURLOPT_DEBUGFUNCTION,
-        cmCTestSubmitHandlerCurlDebugCallback);
+      ::curl_easy_setopt(curl, CURLOPT_ERRORBUFFER, upload.ErrorBuffer);
 
       /* we pass our 'chunk' struct to the callback function */
-      cmCTestSubmitHandlerVectorOfChar chunk;
-      cmCTestSubmitHandlerVectorOfChar chunkDebug;
-      ::curl_easy_setopt(curl, CURLOPT_FILE, (void *)&chunk);
-      ::curl_easy_setopt(curl, CURLOPT_DEBUGDATA, (void *)&chunkDebug);
+      ::curl_easy_setopt(curl, CURLOPT_FILE, (void *)&upload.Chunk);
+      ::curl_easy_setopt(curl, CURLOPT_DEBUGDATA,
+                         (void *)&upload.ChunkDebug);
 
-      // Now run off and do what you've been told!
-      res = ::curl_easy_perform(curl);
+      ::curl_multi_add_handle(multi, curl);
+      }
+
+    // Now run off and do what you've been told!
+    int still_running;
+    while(::curl_multi_perform(multi, &still_running) ==
+          CURLM_CALL_MULTI_PERFORM)
+      {
+      }
+
+    // Handle the uploads that have finished.
+    int msgs;
+    while(CURLMsg* msg = ::curl_multi_info_read(multi, &msgs))
+      {
+      if(msg->msg != CURLMSG_DONE)
+        {
+        continue;
+        }
+      CURL* curl = msg->easy_handle;
+      CURLcode res = msg->data.result;
+      ::curl_multi_remove_handle(multi, curl);
+      idle.push_back(curl);
+      cmCTestSubmitHandlerUpload& upload = uploads[running[curl]];
+      size_t current = running[curl];
+      running.erase(curl);
+      if(upload.File)
+        {
+        fclose(upload.File);
+        upload.File = 0;
+        }
 
-      if(cmSystemTools::IsOn(this->GetOption("InternalTest")) &&
-         cmSystemTools::VersionCompare(cmSystemTools::OP_LESS,
-         this->CTest->GetCDashVersion().c_str(), "1.7"))
+      if(mockFailure)
         {
         // mock failure output for internal test case
         std::string mock_output = "<cdash version=\"1.7.0\">\n"
           "  <status>ERROR</status>\n"
           "  <message>Checksum failed for file.</message>\n"
           "</cdash>\n";
-        chunk.clear();
-        chunk.assign(mock_output.begin(), mock_output.end());
+        upload.Chunk.clear();
+        upload.Chunk.assign(mock_output.begin(), mock_output.end());
         }
 
-      if ( chunk.size() > 0 )
+      // Check the response of this upload alone.
+      bool hadErrors = this->HasErrors;
+      this->HasErrors = false;
+      if ( upload.Chunk.size() > 0 )
         {
         cmCTestLog(this->CTest, DEBUG, "CURL output: ["
-          << cmCTestLogWrite(&*chunk.begin(), chunk.size()) << "]"
-          << std::endl);
-        this->ParseResponse(chunk);
+          << cmCTestLogWrite(&*upload.Chunk.begin(), upload.Chunk.size())
+          << "]" << std::endl);
+        this->ParseResponse(upload.Chunk);
         }
-      if ( chunkDebug.size() > 0 )
+      if ( upload.ChunkDebug.size() > 0 )
         {
         cmCTestLog(this->CTest, DEBUG, "CURL debug output: ["
-          << cmCTestLogWrite(&*chunkDebug.begin(), chunkDebug.size()) << "]"
+          << cmCTestLogWrite(&*upload.ChunkDebug.begin(),
+                             upload.ChunkDebug.size()) << "]"
           << std::endl);
         }
+      bool failed = res != CURLE_OK || this->HasErrors;
+      this->HasErrors = hadErrors || (failed && res == CURLE_OK);
 
       // If curl failed for any reason, or checksum fails, wait and retry
-      //
-      if(res != CURLE_OK || this->HasErrors)
+      if(failed && upload.Attempt < count)
         {
-        std::string retryDelay = this->GetOption("RetryDelay") == NULL ?
-          "" : this->GetOption("RetryDelay");
-        std::string retryCount = this->GetOption("RetryCount") == NULL ?
-          "" : this->GetOption("RetryCount");
-
-        int delay = retryDelay == "" ? atoi(this->CTest->GetCTestConfiguration(
-          "CTestSubmitRetryDelay").c_str()) : atoi(retryDelay.c_str());
-        int count = retryCount == "" ? atoi(this->CTest->GetCTestConfiguration(
-          "CTestSubmitRetryCount").c_str()) : atoi(retryCount.c_str());
-
-        for(int i = 0; i < count; i++)
-          {
-          cmCTestLog(this->CTest, HANDLER_OUTPUT,
-            "   Submit failed, waiting " << delay << " seconds...\n");
-
-          double stop = cmSystemTools::GetTime() + delay;
-          while(cmSystemTools::GetTime() < stop)
-            {
-            cmSystemTools::Delay(100);
-            }
-
-          cmCTestLog(this->CTest, HANDLER_OUTPUT,
-            "   Retry submission: Attempt " << (i + 1) << " of "
-            << count << std::endl);
-
-          ::fclose(ftpfile);
-          ftpfile = cmsys::SystemTools::Fopen(local_file.c_str(), "rb");
-          ::curl_easy_setopt(curl, CURLOPT_INFILE, ftpfile);
-
-          chunk.clear();
-          chunkDebug.clear();
-          this->HasErrors = false;
-
-          res = ::curl_easy_perform(curl);
-
-          if ( chunk.size() > 0 )
-            {
-            cmCTestLog(this->CTest, DEBUG, "CURL output: ["
-              << cmCTestLogWrite(&*chunk.begin(), chunk.size()) << "]"
-              << std::endl);
-            this->ParseResponse(chunk);
-            }
-
-          if(res == CURLE_OK && !this->HasErrors)
-            {
-            break;
-            }
-          }
+        cmCTestLog(this->CTest, HANDLER_OUTPUT,
+          "   Submit failed, waiting " << delay << " seconds...\n");
+        ++upload.Attempt;
+        cmCTestLog(this->CTest, HANDLER_OUTPUT,
+          "   Retry submission: Attempt " << upload.Attempt << " of "
+          << count << std::endl);
+        upload.NotBefore = cmSystemTools::GetTime() + delay;
+        pending.push_back(current);
+        continue;
         }
 
-      fclose(ftpfile);
-      if ( res )
+      // This upload is done for good.
+      std::string().swap(upload.Body);
+
+      if ( res != CURLE_OK )
         {
         cmCTestLog(this->CTest, ERROR_MESSAGE,
           "   Error when uploading file: "
-          << local_file << std::endl);
+          << upload.LocalFile << std::endl);
         cmCTestLog(this->CTest, ERROR_MESSAGE, "   Error message was: "
-          << error_buffer << std::endl);
+          << upload.ErrorBuffer << std::endl);
         *this->LogFile << "   Error when uploading file: "
-                       << local_file
+                       << upload.LocalFile
                        << std::endl
-                       << "   Error message was: " << error_buffer
+                       << "   Error message was: " << upload.ErrorBuffer
                        << std::endl;
         // avoid deref of begin for zero size array
-        if(chunk.size())
+        if(upload.Chunk.size())
           {
           *this->LogFile << "   Curl output was: "
-                         << cmCTestLogWrite(&*chunk.begin(), chunk.size())
+                         << cmCTestLogWrite(&*upload.Chunk.begin(),
+                                            upload.Chunk.size())
                          << std::endl;
           cmCTestLog(this->CTest, ERROR_MESSAGE, "CURL output: ["
-                     << cmCTestLogWrite(&*chunk.begin(), chunk.size()) << "]"
+                     << cmCTestLogWrite(&*upload.Chunk.begin(),
+                                        upload.Chunk.size()) << "]"
                      << std::endl);
           }
-        ::curl_easy_cleanup(curl);
-        ::curl_global_cleanup();
-        return false;
+        success = false;
+        continue;
         }
-      // always cleanup
-      ::curl_easy_cleanup(curl);
-      cmCTestLog(this->CTest, HANDLER_OUTPUT, "   Uploaded: " + local_file
-        << std::endl);
+      cmCTestLog(this->CTest, HANDLER_OUTPUT, "   Uploaded: "
+        << upload.LocalFile << std::endl);
+      }
+
+    if(success && still_running)
+      {
+      // Wait for activity on the transfers.
+      fd_set readfds;
+      fd_set writefds;
+      fd_set excfds;
+      int maxfd = -1;
+      FD_ZERO(&readfds);
+      FD_ZERO(&writefds);
+      FD_ZERO(&excfds);
+      ::curl_multi_fdset(multi, &readfds, &writefds, &excfds, &maxfd);
+      struct timeval timeout;
+      timeout.tv_sec = 0;
+      timeout.tv_usec = 100000;
+      if(maxfd >= 0)
+        {
+        select(maxfd + 1, &readfds, &writefds, &excfds, &timeout);
+        }
+      else
+        {
+        cmSystemTools::Delay(100);
+        }
+      }
+    else if(success && running.empty() && !pending.empty())
+      {
+      // All remaining uploads are waiting to retry.
+      cmSystemTools::Delay(100);
       }
     }
+
+  // always cleanup
+  for(std::map<CURL*, size_t>::iterator ri = running.begin();
+      ri != running.end(); ++ri)
+    {
+    ::curl_multi_remove_handle(multi, ri->first);
+    if(uploads[ri->second].File)
+      {
+      fclose(uploads[ri->second].File);
+      }
+    }
+  for(std::vector<CURL*>::iterator hi = handles.begin();
+      hi != handles.end(); ++hi)
+    {
+    ::curl_easy_cleanup(*hi);
+    }
+  ::curl_slist_free_all(gzipHeaders);
+  ::curl_multi_cleanup(multi);
   ::curl_global_cleanup();
-  return true;
+  return success;
 }
 
 //----------------------------------------------------------------------------
@@ -26,6 +26,8 @@ cmCTestTestCommand::cmCTestTestCommand()
   this->Arguments[ctt_PARALLEL_LEVEL] = "PARALLEL_LEVEL";
   this->Arguments[ctt_SCHEDULE_RANDOM] = "SCHEDULE_RANDOM";
   this->Arguments[ctt_STOP_TIME] = "STOP_TIME";
+  this->Arguments[ctt_SHARD] = "SHARD";
+  this->Arguments[ctt_SHARD_COST_DATA] = "SHARD_COST_DATA";
   this->Arguments[ctt_LAST] = 0;
   this->Last = ctt_LAST;
 }
@@ -103,6 +105,14 @@ cmCTestGenericHandler* cmCTestTestCommand::InitializeHandler()
     {
     this->CTest->SetStopTime(this->Values[ctt_STOP_TIME]);
     }
+  if(this->Values[ctt_SHARD])
+    {
+    handler->SetOption("ShardInformation", this->Values[ctt_SHARD]);
+    }
+  if(this->Values[ctt_SHARD_COST_DATA])
+    {
+    handler->SetOption("ShardCostData", this->Values[ctt_SHARD_COST_DATA]);
+    }
   return handler;
 }
 
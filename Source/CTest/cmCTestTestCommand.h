@@ -60,6 +60,8 @@ protected:
     ctt_PARALLEL_LEVEL,
     ctt_SCHEDULE_RANDOM,
     ctt_STOP_TIME,
+    ctt_SHARD,
+    ctt_SHARD_COST_DATA,
     ctt_LAST
   };
 };
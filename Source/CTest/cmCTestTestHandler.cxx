@@ -382,6 +382,9 @@ inline int GetNextRealNumber(std::string const& in,
 cmCTestTestHandler::cmCTestTestHandler()
 {
   this->UseUnion = false;
+  this->ShardIndex = 0;
+  this->ShardCount = 0;
+  this->ShardCostData = "";
 
   this->UseIncludeLabelRegExpFlag   = false;
   this->UseExcludeLabelRegExpFlag   = false;
@@ -391,10 +394,12 @@ cmCTestTestHandler::cmCTestTestHandler()
 
   this->CustomMaximumPassedTestOutputSize = 1 * 1024;
   this->CustomMaximumFailedTestOutputSize = 300 * 1024;
+  this->CustomTestOutputSpillSize = 1024 * 1024;
 
   this->MemCheck = false;
 
   this->LogFile = 0;
+  this->ResultsSpool = 0;
 
   // regex to detect <DartMeasurement>...</DartMeasurement>
   this->DartStuff.compile(
@@ -421,8 +426,12 @@ void cmCTestTestHandler::Initialize()
   this->CustomPostTest.clear();
   this->CustomMaximumPassedTestOutputSize = 1 * 1024;
   this->CustomMaximumFailedTestOutputSize = 300 * 1024;
+  this->CustomTestOutputSpillSize = 1024 * 1024;
 
   this->TestsToRun.clear();
+  this->ShardIndex = 0;
+  this->ShardCount = 0;
+  this->ShardCostData = "";
 
   this->UseIncludeLabelRegExpFlag = false;
   this->UseExcludeLabelRegExpFlag = false;
@@ -455,6 +464,9 @@ void cmCTestTestHandler::PopulateCustomVectors(cmMakefile *mf)
   this->CTest->PopulateCustomInteger(mf,
                              "CTEST_CUSTOM_MAXIMUM_FAILED_TEST_OUTPUT_SIZE",
                              this->CustomMaximumFailedTestOutputSize);
+  this->CTest->PopulateCustomInteger(mf,
+                             "CTEST_CUSTOM_TEST_OUTPUT_SPILL_SIZE",
+                             this->CustomTestOutputSpillSize);
 }
 
 //----------------------------------------------------------------------
@@ -488,6 +500,20 @@ int cmCTestTestHandler::ProcessHandler()
 {
   // Update internal data structure from generic one
   this->SetTestsToRunInformation(this->GetOption("TestsToRunInformation"));
+  if(!this->SetShardInformation(this->GetOption("ShardInformation")))
+    {
+    return -1;
+    }
+  if(const char* costData = this->GetOption("ShardCostData"))
+    {
+    this->ShardCostData = costData;
+    if(!cmSystemTools::FileExists(costData, true))
+      {
+      cmCTestLog(this->CTest, ERROR_MESSAGE, "Cannot find test shard cost "
+        "data file: " << costData << std::endl);
+      return -1;
+      }
+    }
   this->SetUseUnion(cmSystemTools::IsOn(this->GetOption("UseUnion")));
   if(cmSystemTools::IsOn(this->GetOption("ScheduleRandom")))
     {
@@ -540,6 +566,32 @@ int cmCTestTestHandler::ProcessHandler()
   this->StartLogFile((this->MemCheck ? "DynamicAnalysis" : "Test"), mLogFile);
   this->LogFile = &mLogFile;
 
+  // Write each result to a temporary file as its test finishes so that
+  // its output is not kept in memory.  Test.xml is assembled from it at
+  // the end.  Memory checking processes all results together.  The name
+  // is unique to this process because several ctest processes may run
+  // tests of the same tree at once.
+  cmsys::ofstream resultsSpool;
+  this->ResultsSpoolName = "";
+  if ( this->CTest->GetProduceXML() && !this->MemCheck &&
+       !this->CTest->GetShowOnly() && !this->CTest->ShouldPrintLabels() )
+    {
+    char spoolName[64];
+    sprintf(spoolName, "/Testing/Temporary/TestResults-%08x.xml.tmp",
+            cmSystemTools::RandomSeed());
+    this->ResultsSpoolName = this->CTest->GetBinaryDir() + spoolName;
+    resultsSpool.open(this->ResultsSpoolName.c_str());
+    if( !resultsSpool )
+      {
+      cmCTestLog(this->CTest, ERROR_MESSAGE, "Cannot create testing XML file"
+        << std::endl);
+      this->ResultsSpoolName = "";
+      this->LogFile = 0;
+      return 1;
+      }
+    this->ResultsSpool = &resultsSpool;
+    }
+
   std::vector<std::string> passed;
   std::vector<std::string> failed;
   int total;
@@ -624,6 +676,11 @@ int cmCTestTestHandler::ProcessHandler()
       }
     }
 
+  if ( this->ResultsSpool )
+    {
+    resultsSpool.close();
+    this->ResultsSpool = 0;
+    }
   if ( this->CTest->GetProduceXML() )
     {
     cmGeneratedFileStream xmlfile;
@@ -639,6 +696,11 @@ int cmCTestTestHandler::ProcessHandler()
       }
     this->GenerateDartOutput(xmlfile);
     }
+  if ( !this->ResultsSpoolName.empty() )
+    {
+    cmSystemTools::RemoveFile(this->ResultsSpoolName.c_str());
+    this->ResultsSpoolName = "";
+    }
 
   if ( ! this->PostProcessHandler() )
     {
@@ -875,6 +937,7 @@ void cmCTestTestHandler::ComputeTestList()
   this->TotalNumberOfTests = this->TestList.size();
   // Set the TestList to the final list of all test
   this->TestList = finalList;
+  this->ComputeShard();
 
   this->UpdateMaxTestNameWidth();
 }
@@ -907,6 +970,7 @@ void cmCTestTestHandler::ComputeTestListForRerunFailed()
 
   // Set the TestList to the list of failed tests to rerun
   this->TestList = finalList;
+  this->ComputeShard();
 
   this->UpdateMaxTestNameWidth();
 }
@@ -1166,81 +1230,21 @@ void cmCTestTestHandler::GenerateDartOutput(std::ostream& os)
       << "</Test>" << std::endl;
     }
   os << "\t</TestList>\n";
-  for ( cc = 0; cc < this->TestResults.size(); cc ++ )
+  if ( !this->ResultsSpoolName.empty() )
     {
-    cmCTestTestResult *result = &this->TestResults[cc];
-    this->WriteTestResultHeader(os, result);
-    os << "\t\t<Results>" << std::endl;
-    if ( result->Status != cmCTestTestHandler::NOT_RUN )
+    // The results were written out as their tests finished.
+    if ( !this->TestResults.empty() )
       {
-      if ( result->Status != cmCTestTestHandler::COMPLETED ||
-        result->ReturnValue )
-        {
-        os << "\t\t\t<NamedMeasurement type=\"text/string\" "
-          "name=\"Exit Code\"><Value>"
-          << cmXMLSafe(this->GetTestStatus(result->Status))
-          << "</Value>"
-          "</NamedMeasurement>\n"
-          << "\t\t\t<NamedMeasurement type=\"text/string\" "
-          "name=\"Exit Value\"><Value>"
-          << result->ReturnValue
-          << "</Value></NamedMeasurement>"
-          << std::endl;
-        }
-      os << result->RegressionImages;
-      os << "\t\t\t<NamedMeasurement type=\"numeric/double\" "
-        << "name=\"Execution Time\"><Value>"
-        << result->ExecutionTime
-        << "</Value></NamedMeasurement>\n";
-      if(result->Reason.size())
-        {
-        const char* reasonType = "Pass Reason";
-        if(result->Status != cmCTestTestHandler::COMPLETED &&
-           result->Status != cmCTestTestHandler::NOT_RUN)
-          {
-          reasonType = "Fail Reason";
-          }
-        os << "\t\t\t<NamedMeasurement type=\"text/string\" "
-           << "name=\"" << reasonType << "\"><Value>"
-           << cmXMLSafe(result->Reason)
-           << "</Value></NamedMeasurement>\n";
-        }
-      os
-        << "\t\t\t<NamedMeasurement type=\"text/string\" "
-        << "name=\"Completion Status\"><Value>"
-        << cmXMLSafe(result->CompletionStatus)
-        << "</Value></NamedMeasurement>\n";
+      cmsys::ifstream fin(this->ResultsSpoolName.c_str());
+      os << fin.rdbuf();
       }
-    os
-      << "\t\t\t<NamedMeasurement type=\"text/string\" "
-      << "name=\"Command Line\"><Value>"
-      << cmXMLSafe(result->FullCommandLine)
-      << "</Value></NamedMeasurement>\n";
-    std::map<std::string,std::string>::iterator measureIt;
-    for ( measureIt = result->Properties->Measurements.begin();
-      measureIt != result->Properties->Measurements.end();
-      ++ measureIt )
+    }
+  else
+    {
+    for ( cc = 0; cc < this->TestResults.size(); cc ++ )
       {
-      os
-        << "\t\t\t<NamedMeasurement type=\"text/string\" "
-        << "name=\"" << measureIt->first << "\"><Value>"
-        << cmXMLSafe(measureIt->second)
-        << "</Value></NamedMeasurement>\n";
+      this->GenerateDartTestResult(os, &this->TestResults[cc]);
       }
-    os
-      << "\t\t\t<Measurement>\n"
-      << "\t\t\t\t<Value"
-      << (result->CompressOutput ?
-      " encoding=\"base64\" compression=\"gzip\">"
-      : ">");
-    os << cmXMLSafe(result->Output);
-    os
-      << "</Value>\n"
-      << "\t\t\t</Measurement>\n"
-      << "\t\t</Results>\n";
-
-    this->AttachFiles(os, result);
-    this->WriteTestResultFooter(os, result);
     }
 
   os << "\t<EndDateTime>" << this->EndTest << "</EndDateTime>\n"
@@ -1252,6 +1256,98 @@ void cmCTestTestHandler::GenerateDartOutput(std::ostream& os)
   this->CTest->EndXML(os);
 }
 
+//----------------------------------------------------------------------
+void cmCTestTestHandler::GenerateDartTestResult(std::ostream& os,
+                                                cmCTestTestResult* result)
+{
+  this->WriteTestResultHeader(os, result);
+  os << "\t\t<Results>" << std::endl;
+  if ( result->Status != cmCTestTestHandler::NOT_RUN )
+    {
+    if ( result->Status != cmCTestTestHandler::COMPLETED ||
+      result->ReturnValue )
+      {
+      os << "\t\t\t<NamedMeasurement type=\"text/string\" "
+        "name=\"Exit Code\"><Value>"
+        << cmXMLSafe(this->GetTestStatus(result->Status))
+        << "</Value>"
+        "</NamedMeasurement>\n"
+        << "\t\t\t<NamedMeasurement type=\"text/string\" "
+        "name=\"Exit Value\"><Value>"
+        << result->ReturnValue
+        << "</Value></NamedMeasurement>"
+        << std::endl;
+      }
+    os << result->RegressionImages;
+    os << "\t\t\t<NamedMeasurement type=\"numeric/double\" "
+      << "name=\"Execution Time\"><Value>"
+      << result->ExecutionTime
+      << "</Value></NamedMeasurement>\n";
+    if(result->Reason.size())
+      {
+      const char* reasonType = "Pass Reason";
+      if(result->Status != cmCTestTestHandler::COMPLETED &&
+         result->Status != cmCTestTestHandler::NOT_RUN)
+        {
+        reasonType = "Fail Reason";
+        }
+      os << "\t\t\t<NamedMeasurement type=\"text/string\" "
+         << "name=\"" << reasonType << "\"><Value>"
+         << cmXMLSafe(result->Reason)
+         << "</Value></NamedMeasurement>\n";
+      }
+    os
+      << "\t\t\t<NamedMeasurement type=\"text/string\" "
+      << "name=\"Completion Status\"><Value>"
+      << cmXMLSafe(result->CompletionStatus)
+      << "</Value></NamedMeasurement>\n";
+    }
+  os
+    << "\t\t\t<NamedMeasurement type=\"text/string\" "
+    << "name=\"Command Line\"><Value>"
+    << cmXMLSafe(result->FullCommandLine)
+    << "</Value></NamedMeasurement>\n";
+  std::map<std::string,std::string>::iterator measureIt;
+  for ( measureIt = result->Properties->Measurements.begin();
+    measureIt != result->Properties->Measurements.end();
+    ++ measureIt )
+    {
+    os
+      << "\t\t\t<NamedMeasurement type=\"text/string\" "
+      << "name=\"" << measureIt->first << "\"><Value>"
+      << cmXMLSafe(measureIt->second)
+      << "</Value></NamedMeasurement>\n";
+    }
+  os
+    << "\t\t\t<Measurement>\n"
+    << "\t\t\t\t<Value"
+    << (result->CompressOutput ?
+    " encoding=\"base64\" compression=\"gzip\">"
+    : ">");
+  os << cmXMLSafe(result->Output);
+  os
+    << "</Value>\n"
+    << "\t\t\t</Measurement>\n"
+    << "\t\t</Results>\n";
+
+  this->AttachFiles(os, result);
+  this->WriteTestResultFooter(os, result);
+}
+
+//----------------------------------------------------------------------
+void cmCTestTestHandler::RecordTestResult(cmCTestTestResult& result)
+{
+  if(this->ResultsSpool)
+    {
+    // Write the result now and drop the output it no longer needs.
+    this->GenerateDartTestResult(*this->ResultsSpool, &result);
+    this->ResultsSpool->flush();
+    std::string().swap(result.Output);
+    std::string().swap(result.RegressionImages);
+    }
+  this->TestResults.push_back(result);
+}
+
 //----------------------------------------------------------------------------
 void cmCTestTestHandler::WriteTestResultHeader(std::ostream& os,
                                                cmCTestTestResult* result)
@@ -2065,6 +2161,365 @@ void cmCTestTestHandler::SetTestsToRunInformation(const char* in)
     }
 }
 
+//----------------------------------------------------------------------
+bool cmCTestTestHandler::SetShardInformation(const char* in)
+{
+  if ( !in )
+    {
+    return true;
+    }
+  int index = 0;
+  int count = 0;
+  char extra = 0;
+  if(sscanf(in, "%d/%d%c", &index, &count, &extra) != 2 ||
+     count < 1 || index < 1 || index > count)
+    {
+    cmCTestLog(this->CTest, ERROR_MESSAGE, "Invalid test shard \"" << in
+      << "\".  Expected <index>/<count> with 1 <= index <= count."
+      << std::endl);
+    return false;
+    }
+  this->ShardIndex = index;
+  this->ShardCount = count;
+  return true;
+}
+
+//----------------------------------------------------------------------
+struct cmCTestTestHandlerShardGroup
+{
+  double Cost;
+  size_t First;
+  bool operator<(cmCTestTestHandlerShardGroup const& r) const
+    {
+    // Largest groups first, then in test order.
+    if(this->Cost != r.Cost)
+      {
+      return this->Cost > r.Cost;
+      }
+    return this->First < r.First;
+    }
+};
+
+//----------------------------------------------------------------------
+static size_t cmCTestTestHandlerFindGroup(std::vector<size_t>& parent,
+                                          size_t i)
+{
+  while(parent[i] != i)
+    {
+    parent[i] = parent[parent[i]];
+    i = parent[i];
+    }
+  return i;
+}
+
+//----------------------------------------------------------------------
+void cmCTestTestHandler::ComputeShard()
+{
+  if(this->ShardCount < 1)
+    {
+    return;
+    }
+
+  // Every shard computes the same partition, so each must see the same
+  // list of tests and the same costs.  The cost data file in the build
+  // tree is rewritten as each shard finishes, so recorded costs are read
+  // only from a separate copy given for all shards.
+  std::map<std::string, float> recorded;
+  cmsys::ifstream fin(this->ShardCostData.c_str());
+  std::string line;
+  while(cmSystemTools::GetLineFromStream(fin, line) && line != "---")
+    {
+    std::vector<cmsys::String> parts =
+      cmSystemTools::SplitString(line.c_str(), ' ');
+    if(parts.size() >= 3)
+      {
+      recorded[parts[0]] = static_cast<float>(atof(parts[2].c_str()));
+      }
+    }
+
+  // Estimate the cost of each test from its COST property or the
+  // recorded data.  Tests without either get the mean of the others.
+  size_t n = this->TestList.size();
+  std::vector<double> cost(n, 0);
+  double known = 0;
+  size_t numKnown = 0;
+  size_t i;
+  for(i = 0; i < n; ++i)
+    {
+    cmCTestTestProperties const& p = this->TestList[i];
+    std::map<std::string, float>::const_iterator ri = recorded.find(p.Name);
+    cost[i] = p.Cost > 0? p.Cost : (ri != recorded.end()? ri->second : -1);
+    if(cost[i] >= 0)
+      {
+      known += cost[i];
+      ++numKnown;
+      }
+    }
+  double unknown = numKnown? known / static_cast<double>(numKnown) : 1;
+  for(i = 0; i < n; ++i)
+    {
+    cmCTestTestProperties const& p = this->TestList[i];
+    if(cost[i] < 0)
+      {
+      cost[i] = unknown;
+      }
+    // A test holds its process slots for as long as it runs.
+    cost[i] *= p.Processors > 1? p.Processors : 1;
+    }
+
+  // Tests connected by DEPENDS or sharing a RESOURCE_LOCK stay in one
+  // shard so that their ordering and exclusion still hold.
+  std::vector<size_t> parent(n);
+  std::map<std::string, size_t> byName;
+  for(i = 0; i < n; ++i)
+    {
+    parent[i] = i;
+    byName[this->TestList[i].Name] = i;
+    }
+  std::map<std::string, size_t> byResource;
+  for(i = 0; i < n; ++i)
+    {
+    cmCTestTestProperties const& p = this->TestList[i];
+    for(std::vector<std::string>::const_iterator di = p.Depends.begin();
+        di != p.Depends.end(); ++di)
+      {
+      std::map<std::string, size_t>::const_iterator ni = byName.find(*di);
+      if(ni != byName.end())
+        {
+        parent[cmCTestTestHandlerFindGroup(parent, ni->second)] =
+          cmCTestTestHandlerFindGroup(parent, i);
+        }
+      }
+    for(std::set<std::string>::const_iterator li = p.LockedResources.begin();
+        li != p.LockedResources.end(); ++li)
+      {
+      std::map<std::string, size_t>::iterator ri = byResource.find(*li);
+      if(ri == byResource.end())
+        {
+        byResource[*li] = i;
+        }
+      else
+        {
+        parent[cmCTestTestHandlerFindGroup(parent, ri->second)] =
+          cmCTestTestHandlerFindGroup(parent, i);
+        }
+      }
+    }
+
+  // Assign the groups, largest first, to the shard with the least work.
+  std::map<size_t, cmCTestTestHandlerShardGroup> groups;
+  for(i = 0; i < n; ++i)
+    {
+    size_t root = cmCTestTestHandlerFindGroup(parent, i);
+    std::map<size_t, cmCTestTestHandlerShardGroup>::iterator gi =
+      groups.find(root);
+    if(gi == groups.end())
+      {
+      cmCTestTestHandlerShardGroup g = { cost[i], i };
+      groups[root] = g;
+      }
+    else
+      {
+      gi->second.Cost += cost[i];
+      }
+    }
+  std::vector<cmCTestTestHandlerShardGroup> sorted;
+  std::map<size_t, size_t> firstToRoot;
+  for(std::map<size_t, cmCTestTestHandlerShardGroup>::const_iterator gi =
+        groups.begin(); gi != groups.end(); ++gi)
+    {
+    sorted.push_back(gi->second);
+    firstToRoot[gi->second.First] = gi->first;
+    }
+  std::sort(sorted.begin(), sorted.end());
+  std::vector<double> load(this->ShardCount, 0);
+  std::map<size_t, int> shardOf;
+  for(std::vector<cmCTestTestHandlerShardGroup>::const_iterator si =
+        sorted.begin(); si != sorted.end(); ++si)
+    {
+    int best = 0;
+    for(int s = 1; s < this->ShardCount; ++s)
+      {
+      if(load[s] < load[best])
+        {
+        best = s;
+        }
+      }
+    load[best] += si->Cost;
+    shardOf[firstToRoot[si->First]] = best;
+    }
+
+  ListOfTests shard;
+  for(i = 0; i < n; ++i)
+    {
+    if(shardOf[cmCTestTestHandlerFindGroup(parent, i)] ==
+       this->ShardIndex - 1)
+      {
+      shard.push_back(this->TestList[i]);
+      }
+    }
+  double total = 0;
+  for(int s = 0; s < this->ShardCount; ++s)
+    {
+    total += load[s];
+    }
+  cmCTestLog(this->CTest, HANDLER_OUTPUT, "Test shard " << this->ShardIndex
+    << " of " << this->ShardCount << ": " << shard.size() << " of " << n
+    << " tests" << std::endl);
+  cmCTestLog(this->CTest, HANDLER_VERBOSE_OUTPUT, "Estimated shard cost "
+    << load[this->ShardIndex - 1] << " of " << total << std::endl);
+  this->TestList = shard;
+}
+
+//----------------------------------------------------------------------
+// Lines of a Test.xml file that separate its parts.
+#define CTEST_XML_TEST_LIST "\t<TestList>"
+#define CTEST_XML_TEST_LIST_END "\t</TestList>"
+#define CTEST_XML_END_DATE "\t<EndDateTime>"
+#define CTEST_XML_START_TIME "\t<StartTestTime>"
+#define CTEST_XML_END_TIME "\t<EndTestTime>"
+
+//----------------------------------------------------------------------
+static unsigned long cmCTestTestHandlerXMLTime(std::string const& line)
+{
+  std::string::size_type pos = line.find('>');
+  return pos == line.npos? 0 : strtoul(line.c_str() + pos + 1, 0, 10);
+}
+
+//----------------------------------------------------------------------
+bool cmCTestTestHandler::MergeDartOutput(
+  std::vector<std::string> const& files, std::string const& output)
+{
+  if(files.empty())
+    {
+    cmCTestLog(this->CTest, ERROR_MESSAGE,
+      "No Test.xml files given to merge." << std::endl);
+    return false;
+    }
+
+  // Find the run that started first.  Its header starts the result.
+  std::string line;
+  size_t first = 0;
+  unsigned long startTime = 0;
+  std::vector<std::string>::const_iterator fi;
+  for(fi = files.begin(); fi != files.end(); ++fi)
+    {
+    cmsys::ifstream fin(fi->c_str(), std::ios::in | std::ios::binary);
+    bool haveStart = false;
+    bool haveEnd = false;
+    while(cmSystemTools::GetLineFromStream(fin, line))
+      {
+      if(cmSystemTools::StringStartsWith(line.c_str(), CTEST_XML_START_TIME))
+        {
+        haveStart = true;
+        unsigned long t = cmCTestTestHandlerXMLTime(line);
+        if(fi == files.begin() || t < startTime)
+          {
+          first = fi - files.begin();
+          startTime = t;
+          }
+        }
+      else if(cmSystemTools::StringStartsWith(line.c_str(),
+                                              CTEST_XML_END_TIME))
+        {
+        haveEnd = true;
+        }
+      }
+    if(!haveStart || !haveEnd)
+      {
+      cmCTestLog(this->CTest, ERROR_MESSAGE, "Not a Test.xml file written"
+        " by ctest: " << *fi << std::endl);
+      return false;
+      }
+    }
+
+  cmGeneratedFileStream fout(output.c_str());
+  {
+  cmsys::ifstream fin(files[first].c_str(), std::ios::in | std::ios::binary);
+  while(cmSystemTools::GetLineFromStream(fin, line))
+    {
+    fout << line << "\n";
+    if(line == CTEST_XML_TEST_LIST)
+      {
+      break;
+      }
+    }
+  }
+
+  // List the tests of every run, then their results.
+  for(fi = files.begin(); fi != files.end(); ++fi)
+    {
+    cmsys::ifstream fin(fi->c_str(), std::ios::in | std::ios::binary);
+    bool inList = false;
+    while(cmSystemTools::GetLineFromStream(fin, line) &&
+          line != CTEST_XML_TEST_LIST_END)
+      {
+      if(inList)
+        {
+        fout << line << "\n";
+        }
+      inList = inList || line == CTEST_XML_TEST_LIST;
+      }
+    }
+  fout << CTEST_XML_TEST_LIST_END << "\n";
+
+  // The run that ended last ends the result.
+  std::vector<std::string> footer;
+  unsigned long endTime = 0;
+  for(fi = files.begin(); fi != files.end(); ++fi)
+    {
+    cmsys::ifstream fin(fi->c_str(), std::ios::in | std::ios::binary);
+    while(cmSystemTools::GetLineFromStream(fin, line) &&
+          line != CTEST_XML_TEST_LIST_END)
+      {
+      }
+    std::vector<std::string> lines;
+    while(cmSystemTools::GetLineFromStream(fin, line))
+      {
+      if(!lines.empty() ||
+         cmSystemTools::StringStartsWith(line.c_str(), CTEST_XML_END_DATE))
+        {
+        lines.push_back(line);
+        }
+      else
+        {
+        fout << line << "\n";
+        }
+      }
+    for(std::vector<std::string>::const_iterator li = lines.begin();
+        li != lines.end(); ++li)
+      {
+      if(cmSystemTools::StringStartsWith(li->c_str(), CTEST_XML_END_TIME))
+        {
+        unsigned long t = cmCTestTestHandlerXMLTime(*li);
+        if(footer.empty() || t >= endTime)
+          {
+          footer = lines;
+          endTime = t;
+          }
+        }
+      }
+    }
+  // The merged runs took as long as the span from the first start to the
+  // last end.
+  double elapsed = endTime > startTime?
+    static_cast<double>(endTime - startTime) : 0;
+  for(std::vector<std::string>::const_iterator li = footer.begin();
+      li != footer.end(); ++li)
+    {
+    if(cmSystemTools::StringStartsWith(li->c_str(), "<ElapsedMinutes>"))
+      {
+      fout << "<ElapsedMinutes>" << static_cast<int>(elapsed/6)/10.0
+           << "</ElapsedMinutes></Testing>\n";
+      }
+    else
+      {
+      fout << *li << "\n";
+      }
+    }
+  return true;
+}
+
 //----------------------------------------------------------------------------
 bool cmCTestTestHandler::CleanTestOutput(std::string& output, size_t length)
 {
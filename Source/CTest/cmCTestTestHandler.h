@@ -67,6 +67,16 @@ public:
   ///! pass the -I argument down
   void SetTestsToRunInformation(const char*);
 
+  ///! pass the --shard argument down, returns false if it is invalid
+  bool SetShardInformation(const char*);
+
+  /**
+   * Merge Test.xml files written by separate runs of one build, such as
+   * the shards of its test suite, into the given output file.
+   */
+  bool MergeDartOutput(std::vector<std::string> const& files,
+                       std::string const& output);
+
   cmCTestTestHandler();
 
   /*
@@ -164,6 +174,19 @@ protected:
   virtual void GenerateTestCommand(std::vector<std::string>& args, int test);
   int ExecuteCommands(std::vector<std::string>& vec);
 
+  // Write the XML of one test result, as part of GenerateDartOutput.
+  void GenerateDartTestResult(std::ostream& os, cmCTestTestResult* result);
+
+  // Store the result of a finished test.  If results are spooled to a
+  // temporary file, write it there and drop its output.
+  void RecordTestResult(cmCTestTestResult& result);
+
+  // Do one piece of the work on finished tests that is deferred so that
+  // it does not delay starting the next tests.  The scheduler calls this
+  // between checks of the running tests.  Returns false if nothing was
+  // left to do.
+  virtual bool ProcessDeferredResult() { return false; }
+
   void WriteTestResultHeader(std::ostream& os, cmCTestTestResult* result);
   void WriteTestResultFooter(std::ostream& os, cmCTestTestResult* result);
   // Write attached test files into the xml
@@ -185,6 +208,7 @@ protected:
   bool MemCheck;
   int CustomMaximumPassedTestOutputSize;
   int CustomMaximumFailedTestOutputSize;
+  int CustomTestOutputSpillSize;
   int MaxIndex;
 public:
   enum { // Program statuses
@@ -256,6 +280,13 @@ private:
 
   std::vector<int>        TestsToRun;
 
+  // Run only the given one of this many cost-balanced parts of the tests,
+  // balanced with the costs recorded in the given file, if any.
+  int ShardIndex;
+  int ShardCount;
+  std::string ShardCostData;
+  void ComputeShard();
+
   bool UseIncludeLabelRegExpFlag;
   bool UseExcludeLabelRegExpFlag;
   bool UseIncludeRegExpFlag;
@@ -283,6 +314,8 @@ private:
   cmsys::RegularExpression DartStuff;
 
   std::ostream* LogFile;
+  std::ostream* ResultsSpool;
+  std::string ResultsSpoolName;
 
   bool RerunFailed;
 };
@@ -77,13 +77,47 @@ struct cmArchiveWrite::Callback
 };
 
 //----------------------------------------------------------------------------
-cmArchiveWrite::cmArchiveWrite(std::ostream& os, Compress c, Type t):
+cmArchiveWrite::cmArchiveWrite(std::ostream& os, Compress c, Type t,
+                               int compressionLevel, int threads):
   Stream(os),
   Archive(archive_write_new()),
   Disk(archive_read_disk_new()),
-  Verbose(false)
+  Verbose(false),
+  Uid(-1),
+  Gid(-1)
 {
-  switch (c)
+  // Gzip and bzip2 data are piped through a parallel compressor, if
+  // one is found in the PATH, when other than one thread is requested.
+  // The bundled libarchive has no zstd support, so zstd data are always
+  // piped through the zstd tool.  Zero threads selects all processors.
+  cmOStringStream program;
+  if(c == CompressZstd)
+    {
+    program << "zstd -q -c -T" << (threads < 0? 0 : threads);
+    if(compressionLevel > 0)
+      {
+      program << " -" << (compressionLevel > 19? 19 : compressionLevel);
+      }
+    }
+  else if(threads != 1 &&
+          ((c == CompressGZip &&
+            !cmSystemTools::FindProgram("pigz").empty()) ||
+           (c == CompressBZip2 &&
+            !cmSystemTools::FindProgram("pbzip2").empty())))
+    {
+    program << (c == CompressGZip? "pigz" : "pbzip2") << " -c -q";
+    if(threads > 0)
+      {
+      program << " -p" << threads;
+      }
+    if(compressionLevel > 0)
+      {
+      program << " -" << (compressionLevel > 9? 9 : compressionLevel);
+      }
+    }
+  std::string cmd = program.str();
+
+  switch (cmd.empty()? c : CompressNone)
     {
     case CompressNone:
       if(archive_write_set_compression_none(this->Archive) != ARCHIVE_OK)
@@ -133,7 +167,34 @@ cmArchiveWrite::cmArchiveWrite(std::ostream& os, Compress c, Type t):
         return;
         }
       break;
+    case CompressZstd:
+      break;
     };
+  if(!cmd.empty() &&
+     archive_write_add_filter_program(this->Archive,
+                                      cmd.c_str()) != ARCHIVE_OK)
+    {
+    this->Error = "archive_write_add_filter_program: ";
+    this->Error += cm_archive_error_string(this->Archive);
+    return;
+    }
+  if(compressionLevel > 0 && cmd.empty() &&
+     (c == CompressGZip || c == CompressBZip2))
+    {
+    if(compressionLevel > 9)
+      {
+      compressionLevel = 9;
+      }
+    char level[2] = { static_cast<char>('0' + compressionLevel), 0 };
+    if(archive_write_set_filter_option(this->Archive, 0,
+                                       "compression-level",
+                                       level) != ARCHIVE_OK)
+      {
+      this->Error = "archive_write_set_filter_option: ";
+      this->Error += cm_archive_error_string(this->Archive);
+      return;
+      }
+    }
 #if !defined(_WIN32) || defined(__CYGWIN__)
   if (archive_read_disk_set_standard_lookup(this->Disk) != ARCHIVE_OK)
     {
@@ -160,6 +221,14 @@ cmArchiveWrite::cmArchiveWrite(std::ostream& os, Compress c, Type t):
         return;
         }
     break;
+    case TypeGNUTAR:
+      if(archive_write_set_format_gnutar(this->Archive) != ARCHIVE_OK)
+        {
+        this->Error = "archive_write_set_format_gnutar: ";
+        this->Error += cm_archive_error_string(this->Archive);
+        return;
+        }
+    break;
     }
 
   // do not pad the last block!!
@@ -271,6 +340,23 @@ bool cmArchiveWrite::AddFile(const char* file,
   archive_entry_acl_clear(e);
   archive_entry_xattr_clear(e);
   archive_entry_set_fflags(e, 0, 0);
+  // Replace the ownership if requested.
+  if(this->Uid >= 0)
+    {
+    archive_entry_set_uid(e, this->Uid);
+    }
+  if(this->Gid >= 0)
+    {
+    archive_entry_set_gid(e, this->Gid);
+    }
+  if(!this->Uname.empty())
+    {
+    archive_entry_copy_uname(e, this->Uname.c_str());
+    }
+  if(!this->Gname.empty())
+    {
+    archive_entry_copy_gname(e, this->Gname.c_str());
+    }
   if(archive_write_header(this->Archive, e) != ARCHIVE_OK)
     {
     this->Error = "archive_write_header: ";
@@ -35,18 +35,27 @@ public:
     CompressGZip,
     CompressBZip2,
     CompressLZMA,
-    CompressXZ
+    CompressXZ,
+    CompressZstd
   };
 
   /** Archive Type */
   enum Type
   {
     TypeTAR,
+    TypeGNUTAR,
     TypeZIP
   };
 
-  /** Construct with output stream to which to write archive.  */
-  cmArchiveWrite(std::ostream& os, Compress c = CompressNone, Type = TypeTAR);
+  /** Construct with output stream to which to write archive.  A
+      compression level from 1 (fastest) to 9 (smallest), or to 19 for
+      zstd, applies to the gzip, bzip2 and zstd compression types; 0
+      selects the default.  Zstd compression runs the "zstd" tool
+      found in the PATH.  A number of threads other than 1, or 0 for
+      all processors, compresses gzip and bzip2 data with the "pigz"
+      and "pbzip2" tools if found in the PATH, and is passed to zstd.  */
+  cmArchiveWrite(std::ostream& os, Compress c = CompressNone, Type = TypeTAR,
+                 int compressionLevel = 0, int threads = 1);
   ~cmArchiveWrite();
 
   /**
@@ -73,6 +82,17 @@ public:
   // std::cout.
   void SetVerbose(bool v) { this->Verbose = v; }
 
+  /** Set the numeric owner and group recorded for every entry
+      instead of the values found on disk.  A negative value keeps
+      the value from disk.  */
+  void SetUIDAndGID(int uid, int gid) { this->Uid = uid; this->Gid = gid; }
+
+  /** Set the owner and group names recorded for every entry instead
+      of the names found on disk.  An empty name keeps the name from
+      disk.  */
+  void SetUNAMEAndGNAME(std::string const& uname, std::string const& gname)
+    { this->Uname = uname; this->Gname = gname; }
+
 private:
   bool Okay() const { return this->Error.empty(); }
   bool AddPath(const char* path, size_t skip, const char* prefix);
@@ -89,6 +109,10 @@ private:
   struct archive* Disk;
   bool Verbose;
   std::string Error;
+  int Uid;
+  int Gid;
+  std::string Uname;
+  std::string Gname;
 };
 
 #endif
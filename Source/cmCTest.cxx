@@ -2144,6 +2144,22 @@ void cmCTest::HandleCommandLineArguments(size_t &i,
     this->GetHandler("memcheck")->
       SetPersistentOption("TestsToRunInformation",args[i].c_str());
     }
+  if(this->CheckArgument(arg, "--shard") && i < args.size() - 1)
+    {
+    i++;
+    this->GetHandler("test")->SetPersistentOption("ShardInformation",
+                                                  args[i].c_str());
+    this->GetHandler("memcheck")->
+      SetPersistentOption("ShardInformation",args[i].c_str());
+    }
+  if(this->CheckArgument(arg, "--shard-cost-data") && i < args.size() - 1)
+    {
+    i++;
+    this->GetHandler("test")->SetPersistentOption("ShardCostData",
+                                                  args[i].c_str());
+    this->GetHandler("memcheck")->
+      SetPersistentOption("ShardCostData",args[i].c_str());
+    }
   if(this->CheckArgument(arg, "-U", "--union"))
     {
     this->GetHandler("test")->SetPersistentOption("UseUnion", "true");
@@ -2374,6 +2390,16 @@ int cmCTest::Run(std::vector<std::string> &args, std::string* output)
         }
       }
 
+    if(this->CheckArgument(arg, "--merge-test-xml") && i < args.size() - 2)
+      {
+      std::string merged = args[++i];
+      std::vector<std::string> files;
+      cmSystemTools::ExpandListArgument(args[++i], files);
+      cmCTestTestHandler* handler =
+        static_cast<cmCTestTestHandler*>(this->GetHandler("test"));
+      return handler->MergeDartOutput(files, merged)? 0 : 1;
+      }
+
     // --build-and-test options
     if(this->CheckArgument(arg, "--build-and-test") && i < args.size() - 1)
       {
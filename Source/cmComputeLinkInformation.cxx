@@ -1452,7 +1452,7 @@ bool cmComputeLinkInformation::CheckSharedLibNoSOName(std::string const& item)
     // library has one.  Otherwise assume the library has no builtin
     // soname.
     std::string soname;
-    if(!cmSystemTools::GuessLibrarySOName(item, soname))
+    if(!this->GlobalGenerator->GuessLibrarySOName(item, soname))
       {
       this->AddSharedLibNoSOName(item);
       return true;
@@ -45,20 +45,32 @@ std::string cmCryptoHash::HashString(const std::string& input)
 
 //----------------------------------------------------------------------------
 std::string cmCryptoHash::HashFile(const std::string& file)
+{
+  this->Initialize();
+  if(this->AppendFile(file))
+    {
+    return this->Finalize();
+    }
+  return "";
+}
+
+//----------------------------------------------------------------------------
+bool cmCryptoHash::AppendFile(const std::string& file)
 {
   cmsys::ifstream fin(file.c_str(), std::ios::in | cmsys_ios_binary);
   if(!fin)
     {
-    return "";
+    return false;
     }
 
-  this->Initialize();
-
-  // Should be efficient enough on most system:
-  cm_sha2_uint64_t buffer[512];
-  char* buffer_c = reinterpret_cast<char*>(buffer);
+  // Read in large blocks so that big files need few system calls.
+  // The stream buffer is bypassed for reads of this size.
+  std::vector<cm_sha2_uint64_t> buffer(8192);
+  std::streamsize buffer_size =
+    static_cast<std::streamsize>(buffer.size() * sizeof(buffer[0]));
+  char* buffer_c = reinterpret_cast<char*>(&buffer[0]);
   unsigned char const* buffer_uc =
-    reinterpret_cast<unsigned char const*>(buffer);
+    reinterpret_cast<unsigned char const*>(&buffer[0]);
   // This copy loop is very sensitive on certain platforms with
   // slightly broken stream libraries (like HPUX).  Normally, it is
   // incorrect to not check the error condition on the fin.read()
@@ -66,17 +78,13 @@ std::string cmCryptoHash::HashFile(const std::string& file)
   // error occurred.  Therefore, the loop should be safe everywhere.
   while(fin)
     {
-    fin.read(buffer_c, sizeof(buffer));
+    fin.read(buffer_c, buffer_size);
     if(int gcount = static_cast<int>(fin.gcount()))
       {
       this->Append(buffer_uc, gcount);
       }
     }
-  if(fin.eof())
-    {
-    return this->Finalize();
-    }
-  return "";
+  return fin.eof();
 }
 
 //----------------------------------------------------------------------------
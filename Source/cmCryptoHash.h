@@ -23,9 +23,12 @@ public:
   static cmsys::auto_ptr<cmCryptoHash> New(const char* algo);
   std::string HashString(const std::string& input);
   std::string HashFile(const std::string& file);
-protected:
+
+  // Compute a hash incrementally: Initialize, then Append data or the
+  // content of files, and Finalize to get the hash.
   virtual void Initialize()=0;
   virtual void Append(unsigned char const*, int)=0;
+  bool AppendFile(const std::string& file);
   virtual std::string Finalize()=0;
 };
 
@@ -35,7 +38,6 @@ class cmCryptoHashMD5: public cmCryptoHash
 public:
   cmCryptoHashMD5();
   ~cmCryptoHashMD5();
-protected:
   virtual void Initialize();
   virtual void Append(unsigned char const* buf, int sz);
   virtual std::string Finalize();
@@ -48,7 +50,6 @@ protected:
   public: \
     cmCryptoHash##SHA(); \
     ~cmCryptoHash##SHA(); \
-  protected: \
     virtual void Initialize(); \
     virtual void Append(unsigned char const* buf, int sz); \
     virtual std::string Finalize(); \
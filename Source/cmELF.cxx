@@ -50,6 +50,15 @@
 # include <sys/link.h> // For dynamic section information
 #endif
 
+// Map files into memory to parse them where supported.
+#include <unistd.h>
+#if defined(_POSIX_MAPPED_FILES) && _POSIX_MAPPED_FILES > 0
+# include <fcntl.h>
+# include <sys/mman.h>
+# include <sys/stat.h>
+# define CM_ELF_USE_MMAP
+#endif
+
 //----------------------------------------------------------------------------
 // Low-level byte swapping implementation.
 template <size_t s> struct cmELFByteSwapSize {};
@@ -83,6 +92,88 @@ void cmELFByteSwap(T& x)
   cmELFByteSwap(reinterpret_cast<char*>(&x), cmELFByteSwapSize<sizeof(T)>());
 }
 
+//----------------------------------------------------------------------------
+#if defined(CM_ELF_USE_MMAP)
+// Input stream reading a file mapped into memory.  Seeking and reading
+// do not need system calls or copies through a stream buffer.
+class cmELFMappedStream: public std::istream
+{
+public:
+  cmELFMappedStream(): std::istream(0) { this->rdbuf(&this->Buffer); }
+  bool Map(const char* fname) { return this->Buffer.Map(fname); }
+private:
+  class MappedBuffer: public std::streambuf
+  {
+  public:
+    MappedBuffer(): Data(0), Size(0) {}
+    ~MappedBuffer()
+      {
+      if(this->Data)
+        {
+        munmap(this->Data, this->Size);
+        }
+      }
+    bool Map(const char* fname)
+      {
+      int fd = open(fname, O_RDONLY);
+      if(fd < 0)
+        {
+        return false;
+        }
+      struct stat st;
+      void* data = MAP_FAILED;
+      if(fstat(fd, &st) == 0 && st.st_size > 0)
+        {
+        data = mmap(0, static_cast<size_t>(st.st_size), PROT_READ,
+                    MAP_PRIVATE, fd, 0);
+        }
+      close(fd);
+      if(data == MAP_FAILED)
+        {
+        return false;
+        }
+      this->Data = static_cast<char*>(data);
+      this->Size = static_cast<size_t>(st.st_size);
+      this->setg(this->Data, this->Data, this->Data + this->Size);
+      return true;
+      }
+  protected:
+    virtual pos_type seekoff(off_type off, std::ios_base::seekdir dir,
+                             std::ios_base::openmode which)
+      {
+      if(!(which & std::ios_base::in))
+        {
+        return pos_type(off_type(-1));
+        }
+      off_type size = off_type(this->egptr() - this->eback());
+      off_type base;
+      switch(dir)
+        {
+        case std::ios_base::beg: base = 0; break;
+        case std::ios_base::cur: base = this->gptr() - this->eback(); break;
+        case std::ios_base::end: base = size; break;
+        default: return pos_type(off_type(-1));
+        }
+      // Check the offset before forming a pointer from it.
+      if(off < -base || off > size - base)
+        {
+        return pos_type(off_type(-1));
+        }
+      this->setg(this->eback(), this->eback() + (base + off), this->egptr());
+      return pos_type(base + off);
+      }
+    virtual pos_type seekpos(pos_type pos, std::ios_base::openmode which)
+      {
+      return this->seekoff(off_type(pos), std::ios_base::beg, which);
+      }
+  private:
+    char* Data;
+    size_t Size;
+  };
+  MappedBuffer Buffer;
+};
+#endif
+
 //----------------------------------------------------------------------------
 class cmELFInternal
 {
@@ -92,7 +183,7 @@ public:
 
   // Construct and take ownership of the file stream object.
   cmELFInternal(cmELF* external,
-                cmsys::auto_ptr<cmsys::ifstream>& fin,
+                cmsys::auto_ptr<std::istream>& fin,
                 ByteOrderType order):
     External(external),
     Stream(*fin.release()),
@@ -228,7 +319,7 @@ public:
 
   // Construct with a stream and byte swap indicator.
   cmELFInternalImpl(cmELF* external,
-                    cmsys::auto_ptr<cmsys::ifstream>& fin,
+                    cmsys::auto_ptr<std::istream>& fin,
                     ByteOrderType order);
 
   // Return the number of sections as specified by the ELF header.
@@ -486,7 +577,7 @@ private:
 template <class Types>
 cmELFInternalImpl<Types>
 ::cmELFInternalImpl(cmELF* external,
-                    cmsys::auto_ptr<cmsys::ifstream>& fin,
+                    cmsys::auto_ptr<std::istream>& fin,
                     ByteOrderType order):
   cmELFInternal(external, fin, order)
 {
@@ -731,7 +822,17 @@ cmELFInternalImpl<Types>::GetDynamicSectionString(unsigned int tag)
 cmELF::cmELF(const char* fname): Internal(0)
 {
   // Try to open the file.
-  cmsys::auto_ptr<cmsys::ifstream> fin(new cmsys::ifstream(fname));
+  cmsys::auto_ptr<std::istream> fin;
+#if defined(CM_ELF_USE_MMAP)
+  cmELFMappedStream* mapped = new cmELFMappedStream;
+  fin.reset(mapped);
+  if(!mapped->Map(fname))
+    {
+    fin.reset(new cmsys::ifstream(fname));
+    }
+#else
+  fin.reset(new cmsys::ifstream(fname));
+#endif
 
   // Quit now if the file could not be opened.
   if(!fin.get() || !*fin)
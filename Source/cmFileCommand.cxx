@@ -15,6 +15,8 @@
 #include "cmHexFileConverter.h"
 #include "cmInstallType.h"
 #include "cmFileTimeComparison.h"
+#include "cmLocalGenerator.h"
+#include "cmGlobalGenerator.h"
 #include "cmCryptoHash.h"
 
 #include "cmTimestamp.h"
@@ -34,6 +36,11 @@
 #include <cmsys/RegularExpression.hxx>
 #include <cmsys/FStream.hxx>
 
+#if defined(CMAKE_BUILD_WITH_CMAKE)
+#include <cmsys/Process.h>
+#include <cmsys/SystemInformation.hxx>
+#endif
+
 // Table of permissions flags.
 #if defined(_WIN32) && !defined(__CYGWIN__)
 static mode_t mode_owner_read = S_IREAD;
@@ -100,6 +107,10 @@ bool cmFileCommand
     {
     return this->HandleHashCommand(args);
     }
+  else if ( subCommand == "HASHES" )
+    {
+    return this->HandleHashesCommand(args);
+    }
   else if ( subCommand == "STRINGS" )
     {
     return this->HandleStringsCommand(args);
@@ -400,6 +411,209 @@ bool cmFileCommand::HandleHashCommand(std::vector<std::string> const& args)
 #endif
 }
 
+//----------------------------------------------------------------------------
+#if defined(CMAKE_BUILD_WITH_CMAKE)
+// A range of the files given to file(HASHES) that is hashed by one
+// "cmake -E cmake_hash_files" child process.
+struct cmFileHashesBatch
+{
+  size_t Begin;
+  size_t End;
+  cmsysProcess* Process;
+};
+
+//----------------------------------------------------------------------------
+static void cmFileHashesStart(cmFileHashesBatch& batch,
+                              std::string const& algo,
+                              std::vector<std::string> const& files)
+{
+  std::vector<const char*> argv;
+  argv.push_back(cmSystemTools::GetCMakeCommand().c_str());
+  argv.push_back("-E");
+  argv.push_back("cmake_hash_files");
+  argv.push_back(algo.c_str());
+  for(size_t i = batch.Begin; i < batch.End; ++i)
+    {
+    argv.push_back(files[i].c_str());
+    }
+  argv.push_back(0);
+  batch.Process = cmsysProcess_New();
+  cmsysProcess_SetCommand(batch.Process, &*argv.begin());
+  cmsysProcess_SetOption(batch.Process, cmsysProcess_Option_HideWindow, 1);
+  cmsysProcess_Execute(batch.Process);
+}
+
+//----------------------------------------------------------------------------
+static void cmFileHashesFinish(cmFileHashesBatch& batch,
+                               std::vector<std::string>& hashes)
+{
+  // The child prints one line per file, empty if it could not be read.
+  std::string output;
+  char* data;
+  int length;
+  int pipe;
+  while((pipe = cmsysProcess_WaitForData(batch.Process, &data, &length, 0))
+        > 0)
+    {
+    if(pipe == cmsysProcess_Pipe_STDOUT)
+      {
+      output.append(data, length);
+      }
+    }
+  cmsysProcess_WaitForExit(batch.Process, 0);
+  if(cmsysProcess_GetState(batch.Process) == cmsysProcess_State_Exited &&
+     cmsysProcess_GetExitValue(batch.Process) == 0)
+    {
+    std::string::size_type pos = 0;
+    for(size_t i = batch.Begin; i < batch.End && pos < output.size(); ++i)
+      {
+      std::string::size_type eol = output.find('\n', pos);
+      if(eol == output.npos)
+        {
+        break;
+        }
+      std::string line = output.substr(pos, eol - pos);
+      if(!line.empty() && line[line.size()-1] == '\r')
+        {
+        line.erase(line.size()-1);
+        }
+      hashes[i] = line;
+      pos = eol + 1;
+      }
+    }
+  cmsysProcess_Delete(batch.Process);
+  batch.Process = 0;
+}
+#endif
+
+//----------------------------------------------------------------------------
+bool cmFileCommand::HandleHashesCommand(std::vector<std::string> const& args)
+{
+#if defined(CMAKE_BUILD_WITH_CMAKE)
+  if(args.size() < 3)
+    {
+    this->SetError("HASHES requires an algorithm and output variable");
+    return false;
+    }
+
+  cmsys::auto_ptr<cmCryptoHash> hash(cmCryptoHash::New(args[1].c_str()));
+  if(!hash.get())
+    {
+    cmOStringStream e;
+    e << "HASHES given unknown algorithm \"" << args[1] << "\"";
+    this->SetError(e.str());
+    return false;
+    }
+
+  std::vector<std::string>::const_iterator first = args.begin() + 3;
+  size_t jobs = 0;
+  if(first != args.end() && *first == "JOBS")
+    {
+    ++first;
+    if(first == args.end() || first->empty() || first->size() > 4 ||
+       first->find_first_not_of("0123456789") != first->npos ||
+       atoi(first->c_str()) < 1)
+      {
+      this->SetError("HASHES JOBS requires a positive number");
+      return false;
+      }
+    jobs = static_cast<size_t>(atoi(first->c_str()));
+    ++first;
+    }
+  std::vector<std::string> files(first, args.end());
+  std::vector<std::string> hashes(files.size());
+
+  // Hashing many or large files is split into batches of files next to
+  // each other that run concurrently in child processes.  By default
+  // there is one job per processor.
+  std::vector<unsigned long> sizes(files.size());
+  unsigned long total = 0;
+  for(size_t i = 0; i < files.size(); ++i)
+    {
+    sizes[i] = cmSystemTools::FileLength(files[i].c_str());
+    total += sizes[i];
+    }
+  if(jobs == 0 && files.size() > 1 &&
+     (total >= 1024*1024 || files.size() >= 64))
+    {
+    cmsys::SystemInformation info;
+    info.RunCPUCheck();
+    jobs = info.GetNumberOfLogicalCPU() * info.GetNumberOfPhysicalCPU();
+    }
+  if(jobs > files.size())
+    {
+    jobs = files.size();
+    }
+  if(jobs > 1)
+    {
+    // Aim for one batch per job, but keep command lines short.
+    unsigned long target = total / jobs + 1;
+    std::vector<cmFileHashesBatch> batches;
+    cmFileHashesBatch batch;
+    batch.Begin = 0;
+    batch.Process = 0;
+    unsigned long batchSize = 0;
+    size_t batchLength = 0;
+    for(size_t i = 0; i < files.size(); ++i)
+      {
+      batchSize += sizes[i];
+      batchLength += files[i].size() + 3;
+      if(batchSize >= target || batchLength >= 16384 ||
+         i + 1 == files.size())
+        {
+        batch.End = i + 1;
+        batches.push_back(batch);
+        batch.Begin = i + 1;
+        batchSize = 0;
+        batchLength = 0;
+        }
+      }
+
+    // Keep up to 'jobs' batches running.  Each result is stored at the
+    // index of its file, so the order in which batches finish does not
+    // matter.
+    size_t next = 0;
+    for(size_t done = 0; done < batches.size(); ++done)
+      {
+      for(; next < batches.size() && next < done + jobs; ++next)
+        {
+        cmFileHashesStart(batches[next], args[1], files);
+        }
+      cmFileHashesFinish(batches[done], hashes);
+      }
+    }
+
+  // Hash the remaining files here.  This also reports files that the
+  // child processes could not read.
+  std::string result;
+  const char* sep = "";
+  for(size_t i = 0; i < files.size(); ++i)
+    {
+    std::string out = hashes[i];
+    if(out.empty())
+      {
+      out = hash->HashFile(files[i]);
+      }
+    if(out.empty())
+      {
+      cmOStringStream e;
+      e << "HASHES failed to read file \"" << files[i] << "\": "
+        << cmSystemTools::GetLastSystemError();
+      this->SetError(e.str());
+      return false;
+      }
+    result += sep;
+    result += out;
+    sep = ";";
+    }
+  this->Makefile->AddDefinition(args[2], result.c_str());
+  return true;
+#else
+  this->SetError("HASHES not available during bootstrap");
+  return false;
+#endif
+}
+
 //----------------------------------------------------------------------------
 bool cmFileCommand::HandleStringsCommand(std::vector<std::string> const& args)
 {
@@ -715,6 +929,316 @@ bool cmFileCommand::HandleStringsCommand(std::vector<std::string> const& args)
   return true;
 }
 
+//----------------------------------------------------------------------------
+// Search for the files matching a globbing expression, as cmsys::Glob
+// does, for file(GLOB) and file(GLOB_RECURSE).  Path components that
+// are a literal name, "*", "*suffix" or "prefix*" are compared directly
+// instead of through a regular expression, and names are matched before
+// the file system is asked for their type.  The directories read are
+// recorded so that a result can be reused while they are unchanged.
+class cmFileGlob
+{
+public:
+  cmFileGlob(): Recurse(false), RecurseThroughSymlinks(true),
+    FollowedSymlinkCount(0) {}
+
+  void SetRecurse(bool r) { this->Recurse = r; }
+  void RecurseThroughSymlinksOn() { this->RecurseThroughSymlinks = true; }
+  void RecurseThroughSymlinksOff() { this->RecurseThroughSymlinks = false; }
+  void SetRelative(const char* dir) { this->Relative = dir; }
+  unsigned int GetFollowedSymlinkCount() const
+    { return this->FollowedSymlinkCount; }
+
+  void FindFiles(std::string const& expr);
+  std::vector<std::string> const& GetFiles() const { return this->Files; }
+  std::vector<std::string> const& GetVisitedDirectories() const
+    { return this->VisitedDirectories; }
+
+private:
+  struct Pattern
+  {
+    enum MatchType { MatchRegex, MatchAny, MatchLiteral,
+                     MatchPrefix, MatchSuffix };
+    MatchType Type;
+    std::string Literal;
+    cmsys::RegularExpression Regex;
+    bool Match(std::string const& name);
+  };
+
+  void AddPattern(std::string const& pattern);
+  void ProcessDirectory(std::string::size_type start, std::string const& dir);
+  void RecurseDirectory(std::string::size_type start, std::string const& dir);
+  void AddFile(std::string const& file);
+  static std::string MatchName(std::string const& name);
+
+  bool Recurse;
+  bool RecurseThroughSymlinks;
+  unsigned int FollowedSymlinkCount;
+  std::string Relative;
+  std::vector<Pattern> Patterns;
+  std::vector<std::string> Files;
+  std::vector<std::string> VisitedDirectories;
+};
+
+//----------------------------------------------------------------------------
+bool cmFileGlob::Pattern::Match(std::string const& name)
+{
+  switch(this->Type)
+    {
+    case MatchAny:
+      return true;
+    case MatchLiteral:
+      return name == this->Literal;
+    case MatchPrefix:
+      return name.size() >= this->Literal.size() &&
+        name.compare(0, this->Literal.size(), this->Literal) == 0;
+    case MatchSuffix:
+      return name.size() >= this->Literal.size() &&
+        name.compare(name.size() - this->Literal.size(),
+                     this->Literal.size(), this->Literal) == 0;
+    default:
+      return this->Regex.find(name);
+    }
+}
+
+//----------------------------------------------------------------------------
+std::string cmFileGlob::MatchName(std::string const& name)
+{
+#if defined(_WIN32) || defined(__APPLE__) || defined(__CYGWIN__)
+  // The file systems are case-insensitive, as in cmsys::Glob.
+  return cmSystemTools::LowerCase(name);
+#else
+  return name;
+#endif
+}
+
+//----------------------------------------------------------------------------
+void cmFileGlob::AddPattern(std::string const& pattern)
+{
+  Pattern p;
+  std::string::size_type first = pattern.find_first_of("*?[");
+  std::string::size_type last = pattern.find_last_of("*?[");
+  if(first == std::string::npos)
+    {
+    p.Type = Pattern::MatchLiteral;
+    p.Literal = pattern;
+    }
+  else if(pattern == "*")
+    {
+    p.Type = Pattern::MatchAny;
+    }
+  else if(first == 0 && last == 0 && pattern[0] == '*')
+    {
+    p.Type = Pattern::MatchSuffix;
+    p.Literal = pattern.substr(1);
+    }
+  else if(first == pattern.size() - 1 && pattern[first] == '*')
+    {
+    p.Type = Pattern::MatchPrefix;
+    p.Literal = pattern.substr(0, first);
+    }
+  else
+    {
+    p.Type = Pattern::MatchRegex;
+    p.Regex.compile(cmsys::Glob::PatternToRegex(pattern).c_str());
+    }
+  p.Literal = cmFileGlob::MatchName(p.Literal);
+  this->Patterns.push_back(p);
+}
+
+//----------------------------------------------------------------------------
+void cmFileGlob::FindFiles(std::string const& inexpr)
+{
+  this->Patterns.clear();
+  this->Files.clear();
+  this->VisitedDirectories.clear();
+
+  std::string expr = inexpr;
+  if(!cmSystemTools::FileIsFullPath(expr.c_str()))
+    {
+    expr = cmSystemTools::GetCurrentWorkingDirectory();
+    expr += "/" + inexpr;
+    }
+  std::string fexpr = expr;
+
+  // Skip the leading directories that have no wildcards.
+  std::string::size_type cc;
+  std::string::size_type skip = 0;
+  std::string::size_type last_slash = 0;
+  for(cc = 0; cc < expr.size(); cc ++)
+    {
+    if(cc > 0 && expr[cc] == '/' && expr[cc-1] != '\\')
+      {
+      last_slash = cc;
+      }
+    if(cc > 0 &&
+       (expr[cc] == '[' || expr[cc] == '?' || expr[cc] == '*') &&
+       expr[cc-1] != '\\')
+      {
+      break;
+      }
+    }
+  if(last_slash > 0)
+    {
+    skip = last_slash;
+    }
+  if(skip == 0)
+    {
+#if defined(_WIN32) || defined(__CYGWIN__)
+    // Handle network paths
+    if(expr[0] == '/' && expr[1] == '/')
+      {
+      int cnt = 0;
+      for(cc = 2; cc < expr.size(); cc ++)
+        {
+        if(expr[cc] == '/')
+          {
+          cnt ++;
+          if(cnt == 2)
+            {
+            break;
+            }
+          }
+        }
+      skip = cc + 1;
+      }
+    else
+#endif
+      // Handle drive letters on Windows
+      if(expr[1] == ':' && expr[0] != '/')
+        {
+        skip = 2;
+        }
+    }
+  if(skip > 0)
+    {
+    expr = expr.substr(skip);
+    }
+
+  std::string component;
+  for(cc = 0; cc < expr.size(); cc ++)
+    {
+    if(expr[cc] == '/')
+      {
+      if(!component.empty())
+        {
+        this->AddPattern(component);
+        }
+      component = "";
+      }
+    else
+      {
+      component += expr[cc];
+      }
+    }
+  if(!component.empty())
+    {
+    this->AddPattern(component);
+    }
+
+  this->ProcessDirectory(0, skip > 0? fexpr.substr(0, skip) + "/" : "/");
+}
+
+//----------------------------------------------------------------------------
+void cmFileGlob::ProcessDirectory(std::string::size_type start,
+                                  std::string const& dir)
+{
+  bool last = (start == this->Patterns.size() - 1);
+  if(last && this->Recurse)
+    {
+    this->RecurseDirectory(start, dir);
+    return;
+    }
+  if(start >= this->Patterns.size())
+    {
+    return;
+    }
+
+  this->VisitedDirectories.push_back(dir);
+  cmsys::Directory d;
+  if(!d.Load(dir.c_str()))
+    {
+    return;
+    }
+  std::string realname;
+  for(unsigned long cc = 0; cc < d.GetNumberOfFiles(); cc ++)
+    {
+    std::string fname = d.GetFile(cc);
+    if(fname == "." || fname == "..")
+      {
+      continue;
+      }
+
+    // Match the name before checking the file type on disk.
+    if(!this->Patterns[start].Match(cmFileGlob::MatchName(fname)))
+      {
+      continue;
+      }
+    realname = (start == 0? dir : dir + "/") + fname;
+    if(last)
+      {
+      this->AddFile(realname);
+      }
+    else if(cmSystemTools::FileIsDirectory(realname.c_str()))
+      {
+      this->ProcessDirectory(start+1, realname + "/");
+      }
+    }
+}
+
+//----------------------------------------------------------------------------
+void cmFileGlob::RecurseDirectory(std::string::size_type start,
+                                  std::string const& dir)
+{
+  this->VisitedDirectories.push_back(dir);
+  cmsys::Directory d;
+  if(!d.Load(dir.c_str()))
+    {
+    return;
+    }
+  std::string realname;
+  for(unsigned long cc = 0; cc < d.GetNumberOfFiles(); cc ++)
+    {
+    std::string fname = d.GetFile(cc);
+    if(fname == "." || fname == "..")
+      {
+      continue;
+      }
+    realname = (start == 0? dir : dir + "/") + fname;
+
+    // Only directories need the extra symlink check.
+    bool isDir = cmSystemTools::FileIsDirectory(realname.c_str());
+    bool isSymLink = isDir && cmSystemTools::FileIsSymlink(realname.c_str());
+    if(isDir && (!isSymLink || this->RecurseThroughSymlinks))
+      {
+      if(isSymLink)
+        {
+        ++this->FollowedSymlinkCount;
+        }
+      this->RecurseDirectory(start+1, realname);
+      }
+    else if(!this->Patterns.empty() &&
+            this->Patterns.back().Match(cmFileGlob::MatchName(fname)))
+      {
+      this->AddFile(realname);
+      }
+    }
+}
+
+//----------------------------------------------------------------------------
+void cmFileGlob::AddFile(std::string const& file)
+{
+  if(!this->Relative.empty())
+    {
+    this->Files.push_back(
+      cmSystemTools::RelativePath(this->Relative.c_str(), file.c_str()));
+    }
+  else
+    {
+    this->Files.push_back(file);
+    }
+}
+
 //----------------------------------------------------------------------------
 bool cmFileCommand::HandleGlobCommand(std::vector<std::string> const& args,
   bool recurse)
@@ -728,9 +1252,15 @@ bool cmFileCommand::HandleGlobCommand(std::vector<std::string> const& args,
 
   std::string variable = *i;
   i++;
-  cmsys::Glob g;
+  cmFileGlob g;
   g.SetRecurse(recurse);
 
+  cmGlobalGenerator* gg = this->Makefile->GetLocalGenerator()
+    ->GetGlobalGenerator();
+  bool followSymlinks = false;
+  unsigned int followedSymlinkCount = 0;
+  std::string relative;
+
   bool explicitFollowSymlinks = false;
   cmPolicies::PolicyStatus status =
     this->Makefile->GetPolicyStatus(cmPolicies::CMP0009);
@@ -746,6 +1276,7 @@ bool cmFileCommand::HandleGlobCommand(std::vector<std::string> const& args,
       case cmPolicies::REQUIRED_IF_USED:
       case cmPolicies::REQUIRED_ALWAYS:
         g.RecurseThroughSymlinksOn();
+        followSymlinks = true;
         break;
       }
     }
@@ -757,6 +1288,7 @@ bool cmFileCommand::HandleGlobCommand(std::vector<std::string> const& args,
     if ( recurse && (*i == "FOLLOW_SYMLINKS") )
       {
       explicitFollowSymlinks = true;
+      followSymlinks = true;
       g.RecurseThroughSymlinksOn();
       ++i;
       if ( i == args.end() )
@@ -776,6 +1308,7 @@ bool cmFileCommand::HandleGlobCommand(std::vector<std::string> const& args,
         return false;
         }
       g.SetRelative(i->c_str());
+      relative = *i;
       ++i;
       if(i == args.end())
         {
@@ -784,27 +1317,49 @@ bool cmFileCommand::HandleGlobCommand(std::vector<std::string> const& args,
         }
       }
 
+    std::string expr = *i;
     if ( !cmsys::SystemTools::FileIsFullPath(i->c_str()) )
       {
-      std::string expr = this->Makefile->GetCurrentDirectory();
+      std::string cdir = this->Makefile->GetCurrentDirectory();
       // Handle script mode
-      if ( expr.size() > 0 )
-        {
-        expr += "/" + *i;
-        g.FindFiles(expr);
-        }
-      else
+      if ( cdir.size() > 0 )
         {
-        g.FindFiles(*i);
+        expr = cdir + "/" + *i;
         }
       }
+
+    // Reuse the result of an identical search while the directories
+    // it read are unchanged.  Expressions relative to the working
+    // directory are not cached.
+    cmGlobalGenerator::GlobResult cached;
+    std::string key;
+    bool useCache = cmsys::SystemTools::FileIsFullPath(expr.c_str());
+    if ( useCache )
+      {
+      key = recurse? "GLOB_RECURSE;" : "GLOB;";
+      key += followSymlinks? "FOLLOW_SYMLINKS;" : ";";
+      key += relative + ";" + expr;
+      }
+    if ( useCache && gg->GetGlobResult(key, cached) )
+      {
+      followedSymlinkCount += cached.FollowedSymlinkCount;
+      }
     else
       {
-      g.FindFiles(*i);
+      unsigned int count = g.GetFollowedSymlinkCount();
+      g.FindFiles(expr);
+      cached.Files = g.GetFiles();
+      cached.FollowedSymlinkCount = g.GetFollowedSymlinkCount() - count;
+      followedSymlinkCount += cached.FollowedSymlinkCount;
+      if ( useCache )
+        {
+        gg->SetGlobResult(key, cached.Files, cached.FollowedSymlinkCount,
+                          g.GetVisitedDirectories());
+        }
       }
 
     std::vector<std::string>::size_type cc;
-    std::vector<std::string>& files = g.GetFiles();
+    std::vector<std::string> const& files = cached.Files;
     for ( cc = 0; cc < files.size(); cc ++ )
       {
       if ( !first )
@@ -829,7 +1384,7 @@ bool cmFileCommand::HandleGlobCommand(std::vector<std::string> const& args,
       case cmPolicies::WARN:
         // Possibly unexpected old behavior *and* we actually traversed
         // symlinks without being explicitly asked to: warn the author.
-        if(g.GetFollowedSymlinkCount() != 0)
+        if(followedSymlinkCount != 0)
           {
           this->Makefile->IssueMessage(cmake::AUTHOR_WARNING,
             this->Makefile->GetPolicies()->
@@ -959,6 +1514,9 @@ struct cmFileCopier
     Makefile(command->GetMakefile()),
     Name(name),
     Always(false),
+    Mode(ModeCopy),
+    BytesCopied(0),
+    BytesLinked(0),
     MatchlessFiles(true),
     FilePermissions(0),
     DirPermissions(0),
@@ -980,6 +1538,32 @@ protected:
   bool Always;
   cmFileTimeComparison FileTimes;
 
+  // How file content reaches the destination.  Copies are made unless
+  // installing with the CMAKE_INSTALL_MODE environment variable set.
+  enum ModeType
+  {
+    ModeCopy,
+    ModeHardLink,
+    ModeRefLink
+  };
+  ModeType Mode;
+  virtual bool SelectMode()
+    {
+    this->Mode = ModeCopy;
+    return true;
+    }
+
+  // Bytes of file content copied, and shared with the source through
+  // hard links or clones.  Accumulated in global properties.
+  cmIML_INT_uint64_t BytesCopied;
+  cmIML_INT_uint64_t BytesLinked;
+  void AddBytesProperty(const char* prop, cmIML_INT_uint64_t bytes);
+
+  // Whether a file may share its storage with the installed copy.
+  virtual bool MayHardLink() { return true; }
+  bool TransferFile(const char* fromFile, const char* toFile,
+                    mode_t permissions, bool& hardLinked);
+
   // Whether to install a file not matching any expression.
   bool MatchlessFiles;
 
@@ -1075,7 +1659,9 @@ protected:
 
   bool InstallSymlink(const char* fromFile, const char* toFile);
   bool InstallFile(const char* fromFile, const char* toFile,
-                   MatchProperties const& match_properties);
+                   MatchProperties const& match_properties,
+                   struct stat const* fromStat = 0,
+                   struct stat const* toStat = 0);
   bool InstallDirectory(const char* source, const char* destination,
                         MatchProperties const& match_properties);
   virtual bool Install(const char* fromFile, const char* toFile);
@@ -1416,7 +2002,7 @@ bool cmFileCopier::CheckValue(std::string const& arg)
 //----------------------------------------------------------------------------
 bool cmFileCopier::Run(std::vector<std::string> const& args)
 {
-  if(!this->Parse(args))
+  if(!this->Parse(args) || !this->SelectMode())
     {
     return false;
     }
@@ -1454,8 +2040,90 @@ bool cmFileCopier::Run(std::vector<std::string> const& args)
       return false;
       }
     }
+  this->AddBytesProperty("INSTALL_BYTES_COPIED", this->BytesCopied);
+  this->AddBytesProperty("INSTALL_BYTES_LINKED", this->BytesLinked);
+  return true;
+}
+
+//----------------------------------------------------------------------------
+void cmFileCopier::AddBytesProperty(const char* prop,
+                                    cmIML_INT_uint64_t bytes)
+{
+  if(!bytes)
+    {
+    return;
+    }
+  cmake* cm = this->Makefile->GetCMakeInstance();
+  cmIML_INT_uint64_t total = 0;
+  if(const char* value = cm->GetProperty(prop))
+    {
+    cmIStringStream in(value);
+    in >> total;
+    }
+  cmOStringStream out;
+  out << (total + bytes);
+  cm->SetProperty(prop, out.str().c_str());
+}
+
+//----------------------------------------------------------------------------
+bool cmFileCopier::TransferFile(const char* fromFile, const char* toFile,
+                                mode_t permissions, bool& hardLinked)
+{
+  hardLinked = false;
+  cmIML_INT_uint64_t size = cmSystemTools::FileLength(fromFile);
+  if(this->Mode != ModeCopy)
+    {
+    // The destination may be a hard link created by an earlier
+    // installation.  Remove it rather than writing through it.
+    cmSystemTools::RemoveFile(toFile);
+
+    // A hard link shares the permissions and times with the source,
+    // so use one only if nothing needs to change on the destination.
+    mode_t fromPermissions = 0;
+    if(this->Mode == ModeHardLink && this->MayHardLink() &&
+       cmSystemTools::GetPermissions(fromFile, fromPermissions) &&
+       (fromPermissions & 07777) == (permissions & 07777) &&
+       cmSystemTools::CreateHardLink(fromFile, toFile))
+      {
+      hardLinked = true;
+      this->BytesLinked += size;
+      return true;
+      }
+    if(cmSystemTools::CloneFile(fromFile, toFile))
+      {
+      this->BytesLinked += size;
+      return true;
+      }
+    }
+  if(!cmSystemTools::CopyAFile(fromFile, toFile, true))
+    {
+    return false;
+    }
+  this->BytesCopied += size;
+  return true;
+}
+
+//----------------------------------------------------------------------------
+#if !defined(_WIN32) || defined(__CYGWIN__)
+// Same as cmFileTimeComparison::FileTimesDiffer for known status.
+static bool cmFileCopierTimesDiffer(struct stat const& s1,
+                                    struct stat const& s2)
+{
+# if cmsys_STAT_HAS_ST_MTIM
+  long long bil = 1000000000;
+  long long t1 = s1.st_mtim.tv_sec * bil + s1.st_mtim.tv_nsec;
+  long long t2 = s2.st_mtim.tv_sec * bil + s2.st_mtim.tv_nsec;
+  return (t1 < t2? t2 - t1 : t1 - t2) >= bil;
+# else
+  return s1.st_mtime != s2.st_mtime;
+# endif
+}
+#else
+static bool cmFileCopierTimesDiffer(struct stat const&, struct stat const&)
+{
   return true;
 }
+#endif
 
 //----------------------------------------------------------------------------
 bool cmFileCopier::Install(const char* fromFile, const char* toFile)
@@ -1477,8 +2145,41 @@ bool cmFileCopier::Install(const char* fromFile, const char* toFile)
     return true;
     }
 
+#if !defined(_WIN32) || defined(__CYGWIN__)
+  // Query the status of a source that is not a symlink and of its
+  // destination once each, and answer all questions below from them.
+  struct stat fromStat;
+  if(lstat(fromFile, &fromStat) == 0 && !S_ISLNK(fromStat.st_mode))
+    {
+    struct stat toStat;
+    bool toExists = stat(toFile, &toStat) == 0;
+    if(toExists &&
+       fromStat.st_dev == toStat.st_dev && fromStat.st_ino == toStat.st_ino)
+      {
+      // A hard link installed earlier is up to date.
+      if(this->Mode == ModeHardLink && !S_ISDIR(fromStat.st_mode))
+        {
+        this->ReportCopy(toFile, TypeFile, false);
+        }
+      return true;
+      }
+    else if(S_ISDIR(fromStat.st_mode))
+      {
+      return this->InstallDirectory(fromFile, toFile, match_properties);
+      }
+    return this->InstallFile(fromFile, toFile, match_properties,
+                             &fromStat, toExists? &toStat : 0);
+    }
+#endif
+
   if(cmSystemTools::SameFile(fromFile, toFile))
     {
+    // A hard link installed earlier is up to date.
+    if(this->Mode == ModeHardLink &&
+       !cmSystemTools::FileIsDirectory(fromFile))
+      {
+      this->ReportCopy(toFile, TypeFile, false);
+      }
     return true;
     }
   else if(cmSystemTools::FileIsSymlink(fromFile))
@@ -1549,14 +2250,20 @@ bool cmFileCopier::InstallSymlink(const char* fromFile, const char* toFile)
 
 //----------------------------------------------------------------------------
 bool cmFileCopier::InstallFile(const char* fromFile, const char* toFile,
-                               MatchProperties const& match_properties)
+                               MatchProperties const& match_properties,
+                               struct stat const* fromStat,
+                               struct stat const* toStat)
 {
   // Determine whether we will copy the file.
   bool copy = true;
   if(!this->Always)
     {
     // If both files exist with the same time do not copy.
-    if(!this->FileTimes.FileTimesDiffer(fromFile, toFile))
+    if(fromStat)
+      {
+      copy = !toStat || cmFileCopierTimesDiffer(*fromStat, *toStat);
+      }
+    else if(!this->FileTimes.FileTimesDiffer(fromFile, toFile))
       {
       copy = false;
       }
@@ -1565,8 +2272,27 @@ bool cmFileCopier::InstallFile(const char* fromFile, const char* toFile,
   // Inform the user about this file installation.
   this->ReportCopy(toFile, TypeFile, copy);
 
+  // Compute the permissions of the destination file.
+  mode_t permissions = (match_properties.Permissions?
+                        match_properties.Permissions : this->FilePermissions);
+  if(!permissions)
+    {
+    // No permissions were explicitly provided but the user requested
+    // that the source file permissions be used.
+    if(fromStat)
+      {
+      permissions = fromStat->st_mode;
+      }
+    else
+      {
+      cmSystemTools::GetPermissions(fromFile, permissions);
+      }
+    }
+
   // Copy the file.
-  if(copy && !cmSystemTools::CopyAFile(fromFile, toFile, true))
+  bool hardLinked = false;
+  if(copy &&
+     !this->TransferFile(fromFile, toFile, permissions, hardLinked))
     {
     cmOStringStream e;
     e << this->Name << " cannot copy file \"" << fromFile
@@ -1575,6 +2301,12 @@ bool cmFileCopier::InstallFile(const char* fromFile, const char* toFile,
     return false;
     }
 
+  // A hard link already has the time and permissions of the source.
+  if(hardLinked)
+    {
+    return true;
+    }
+
   // Set the file modification time of the destination file.
   if(copy && !this->Always)
     {
@@ -1595,15 +2327,15 @@ bool cmFileCopier::InstallFile(const char* fromFile, const char* toFile,
       }
     }
 
-  // Set permissions of the destination file.
-  mode_t permissions = (match_properties.Permissions?
-                        match_properties.Permissions : this->FilePermissions);
-  if(!permissions)
+  // An up-to-date destination that already has the permissions needs
+  // no further changes.
+  if(!copy && toStat &&
+     (toStat->st_mode & 07777) == (permissions & 07777))
     {
-    // No permissions were explicitly provided but the user requested
-    // that the source file permissions be used.
-    cmSystemTools::GetPermissions(fromFile, permissions);
+    return true;
     }
+
+  // Set permissions of the destination file.
   return this->SetPermissions(toFile, permissions);
 }
 
@@ -1745,6 +2477,17 @@ protected:
   virtual std::string const& ToName(std::string const& fromName)
     { return this->Rename.empty()? fromName : this->Rename; }
 
+  virtual bool SelectMode();
+
+  // Binaries may be modified in place after installation, e.g. to
+  // change the RPATH or strip them, so they never share storage.
+  virtual bool MayHardLink()
+    {
+    return (this->InstallType == cmInstallType_FILES ||
+            this->InstallType == cmInstallType_PROGRAMS ||
+            this->InstallType == cmInstallType_DIRECTORY);
+    }
+
   virtual void ReportCopy(const char* toFile, Type type, bool copy)
     {
     if(!this->MessageNever && (copy || !this->MessageLazy))
@@ -1808,6 +2551,33 @@ protected:
   bool HandleInstallDestination();
 };
 
+//----------------------------------------------------------------------------
+bool cmFileInstaller::SelectMode()
+{
+  const char* mode = cmSystemTools::GetEnv("CMAKE_INSTALL_MODE");
+  if(!mode || !*mode || strcmp(mode, "COPY") == 0)
+    {
+    this->Mode = ModeCopy;
+    }
+  else if(strcmp(mode, "HARDLINK") == 0)
+    {
+    this->Mode = ModeHardLink;
+    }
+  else if(strcmp(mode, "REFLINK") == 0)
+    {
+    this->Mode = ModeRefLink;
+    }
+  else
+    {
+    cmOStringStream e;
+    e << this->Name << " given unknown CMAKE_INSTALL_MODE \"" << mode
+      << "\".  Use COPY, HARDLINK or REFLINK.";
+    this->FileCommand->SetError(e.str());
+    return false;
+    }
+  return true;
+}
+
 //----------------------------------------------------------------------------
 bool cmFileInstaller::Parse(std::vector<std::string> const& args)
 {
@@ -2547,14 +3317,26 @@ typedef std::vector<char> cmFileCommandVectorOfChar;
 
 namespace {
 
+  // Destination of downloaded data.  The hash, if any, is computed
+  // while the data are written so the file need not be read again.
+  struct cmFileDownloadSink
+  {
+    cmsys::ofstream* Out;
+    cmCryptoHash* Hash;
+  };
+
   size_t
   cmWriteToFileCallback(void *ptr, size_t size, size_t nmemb,
                         void *data)
     {
     int realsize = (int)(size * nmemb);
-    cmsys::ofstream* fout = static_cast<cmsys::ofstream*>(data);
+    cmFileDownloadSink* sink = static_cast<cmFileDownloadSink*>(data);
     const char* chPtr = static_cast<char*>(ptr);
-    fout->write(chPtr, realsize);
+    sink->Out->write(chPtr, realsize);
+    if(sink->Hash)
+      {
+      sink->Hash->Append(static_cast<unsigned char const*>(ptr), realsize);
+      }
     return realsize;
     }
 
@@ -2744,6 +3526,7 @@ cmFileCommand::HandleDownloadCommand(std::vector<std::string> const& args)
   const char* cainfo = this->Makefile->GetDefinition("CMAKE_TLS_CAINFO");
   std::string expectedHash;
   std::string hashMatchMSG;
+  std::string hashAlgo;
   cmsys::auto_ptr<cmCryptoHash> hash;
   bool showProgress = false;
 
@@ -2831,6 +3614,7 @@ cmFileCommand::HandleDownloadCommand(std::vector<std::string> const& args)
         }
       hash = cmsys::auto_ptr<cmCryptoHash>(cmCryptoHash::New("MD5"));
       hashMatchMSG = "MD5 sum";
+      hashAlgo = "MD5";
       expectedHash = cmSystemTools::LowerCase(*i);
       }
     else if(*i == "SHOW_PROGRESS")
@@ -2865,13 +3649,27 @@ cmFileCommand::HandleDownloadCommand(std::vector<std::string> const& args)
         return false;
         }
       hashMatchMSG = algo + " hash";
+      hashAlgo = algo;
       }
     ++i;
     }
+  // The expected hash names the file in the download cache, so it must
+  // not contain anything but hexadecimal digits.
+  if(hash.get() && (expectedHash.empty() ||
+     expectedHash.find_first_not_of("0123456789abcdef") != expectedHash.npos))
+    {
+    std::string err = "DOWNLOAD expected hash is not a hexadecimal value: ";
+    err += expectedHash;
+    this->SetError(err);
+    return false;
+    }
+
   // If file exists already, and caller specified an expected md5 or sha,
   // and the existing file already has the expected hash, then simply
-  // return.
+  // return.  Otherwise the file may be left from an interrupted
+  // download, so try to resume it.  The hash tells whether that worked.
   //
+  unsigned long resumeFrom = 0;
   if(cmSystemTools::FileExists(file.c_str()) && hash.get())
     {
     std::string msg;
@@ -2890,6 +3688,33 @@ cmFileCommand::HandleDownloadCommand(std::vector<std::string> const& args)
         }
       return true;
       }
+    resumeFrom = cmSystemTools::FileLength(file.c_str());
+    }
+
+  // Look for the file in the download cache, where files are stored
+  // by their hash.
+  std::string cacheFile;
+  const char* cacheDir = this->Makefile->GetDefinition("CMAKE_DOWNLOAD_CACHE");
+  if(cacheDir && *cacheDir && hash.get())
+    {
+    cacheFile = cacheDir;
+    cacheFile += "/";
+    cacheFile += hashAlgo;
+    cacheFile += "/";
+    cacheFile += expectedHash;
+    if(cmSystemTools::FileExists(cacheFile.c_str(), true) &&
+       hash->HashFile(cacheFile) == expectedHash &&
+       cmSystemTools::CopyFileAlways(cacheFile.c_str(), file.c_str()))
+      {
+      if(statusVar.size())
+        {
+        cmOStringStream result;
+        result << (int)0 << ";\"copied from download cache\"";
+        this->Makefile->AddDefinition(statusVar,
+                                      result.str().c_str());
+        }
+      return true;
+      }
     }
   // Make sure parent directory exists so we can write to the file
   // as we receive downloaded bits from curl...
@@ -2905,12 +3730,31 @@ cmFileCommand::HandleDownloadCommand(std::vector<std::string> const& args)
     return false;
     }
 
-  cmsys::ofstream fout(file.c_str(), std::ios::binary);
+  // Hash the part downloaded before and append the rest to it.
+  if(resumeFrom > 0)
+    {
+    hash->Initialize();
+    if(!hash->AppendFile(file))
+      {
+      resumeFrom = 0;
+      }
+    }
+  if(resumeFrom == 0 && hash.get())
+    {
+    hash->Initialize();
+    }
+
+  cmsys::ofstream fout(file.c_str(), resumeFrom > 0?
+                       std::ios::binary | std::ios::app :
+                       std::ios::binary);
   if(!fout)
     {
     this->SetError("DOWNLOAD cannot open file for write.");
     return false;
     }
+  cmFileDownloadSink sink;
+  sink.Out = &fout;
+  sink.Hash = hash.get();
 
   ::CURL *curl;
   ::curl_global_init(CURL_GLOBAL_DEFAULT);
@@ -2961,7 +3805,7 @@ cmFileCommand::HandleDownloadCommand(std::vector<std::string> const& args)
 
   cmFileCommandVectorOfChar chunkDebug;
 
-  res = ::curl_easy_setopt(curl, CURLOPT_WRITEDATA, (void *)&fout);
+  res = ::curl_easy_setopt(curl, CURLOPT_WRITEDATA, (void *)&sink);
   check_curl_result(res, "DOWNLOAD cannot set write data: ");
 
   res = ::curl_easy_setopt(curl, CURLOPT_DEBUGDATA, (void *)&chunkDebug);
@@ -3010,8 +3854,46 @@ cmFileCommand::HandleDownloadCommand(std::vector<std::string> const& args)
     check_curl_result(res, "DOWNLOAD cannot set progress data: ");
     }
 
+  if(resumeFrom > 0)
+    {
+    res = ::curl_easy_setopt(curl, CURLOPT_RESUME_FROM_LARGE,
+                             static_cast<curl_off_t>(resumeFrom));
+    check_curl_result(res, "DOWNLOAD cannot set resume position: ");
+    }
+
   res = ::curl_easy_perform(curl);
 
+  // The end of the file may not have been downloaded before, so make
+  // sure the resumed download is complete.  If it is not, or the
+  // server cannot resume, download the whole file again.
+  std::string actualHash;
+  if(resumeFrom > 0)
+    {
+    fout.flush();
+    if(res == CURLE_OK)
+      {
+      actualHash = hash->Finalize();
+      }
+    if(actualHash != expectedHash)
+      {
+      actualHash = "";
+      fout.close();
+      fout.clear();
+      fout.open(file.c_str(), std::ios::binary);
+      if(!fout)
+        {
+        this->SetError("DOWNLOAD cannot open file for write.");
+        return false;
+        }
+      hash->Initialize();
+      chunkDebug.clear();
+      res = ::curl_easy_setopt(curl, CURLOPT_RESUME_FROM_LARGE,
+                               static_cast<curl_off_t>(0));
+      check_curl_result(res, "DOWNLOAD cannot reset resume position: ");
+      res = ::curl_easy_perform(curl);
+      }
+    }
+
   /* always cleanup */
   g_curl.release();
   ::curl_easy_cleanup(curl);
@@ -3035,11 +3917,9 @@ cmFileCommand::HandleDownloadCommand(std::vector<std::string> const& args)
   //
   if (hash.get())
     {
-    std::string actualHash = hash->HashFile(file);
-    if (actualHash.size() == 0)
+    if (actualHash.empty())
       {
-      this->SetError("DOWNLOAD cannot compute hash on downloaded file");
-      return false;
+      actualHash = hash->Finalize();
       }
 
     if (expectedHash != actualHash)
@@ -3055,6 +3935,23 @@ cmFileCommand::HandleDownloadCommand(std::vector<std::string> const& args)
       this->SetError(oss.str());
       return false;
       }
+
+    // Share the verified file with other downloads through the cache.
+    // Copy under a temporary name unique to this process first so that
+    // no other process sees a partial file.
+    if(!cacheFile.empty())
+      {
+      char suffix[32];
+      sprintf(suffix, ".tmp%08x", cmSystemTools::RandomSeed());
+      std::string cacheTemp = cacheFile + suffix;
+      cmSystemTools::MakeDirectory(
+        cmSystemTools::GetFilenamePath(cacheFile).c_str());
+      if(!cmSystemTools::CopyFileAlways(file.c_str(), cacheTemp.c_str()) ||
+         !cmSystemTools::RenameFile(cacheTemp.c_str(), cacheFile.c_str()))
+        {
+        cmSystemTools::RemoveFile(cacheTemp.c_str());
+        }
+      }
     }
 
   if(chunkDebug.size())
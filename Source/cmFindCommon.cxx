@@ -11,6 +11,9 @@
 ============================================================================*/
 #include "cmFindCommon.h"
 
+#include "cmLocalGenerator.h"
+#include "cmGlobalGenerator.h"
+
 //----------------------------------------------------------------------------
 cmFindCommon::cmFindCommon()
 {
@@ -470,3 +473,21 @@ void cmFindCommon::SetMakefile(cmMakefile* makefile)
     this->SearchAppBundleFirst = true;
     }
 }
+
+//----------------------------------------------------------------------------
+bool cmFindCommon::FileMayExist(std::string const& path)
+{
+  cmGlobalGenerator* gg =
+    this->Makefile->GetLocalGenerator()->GetGlobalGenerator();
+  return gg->FileExistsInDirectory(cmSystemTools::GetFilenamePath(path),
+                                   cmSystemTools::GetFilenameName(path));
+}
+
+//----------------------------------------------------------------------------
+std::vector<std::string> const&
+cmFindCommon::GetDirectoryEntries(std::string const& dir)
+{
+  cmGlobalGenerator* gg =
+    this->Makefile->GetLocalGenerator()->GetGlobalGenerator();
+  return gg->GetDirectoryEntries(dir);
+}
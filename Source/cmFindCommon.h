@@ -71,6 +71,17 @@ protected:
 
   void SetMakefile(cmMakefile* makefile);
 
+  /** Check whether a file may exist at the given path.  This consults
+      the cached listing of the containing directory so that each
+      search directory is read again only after it has been modified
+      instead of being probed for every candidate name.  A true result
+      must still be confirmed on disk.  */
+  bool FileMayExist(std::string const& path);
+
+  /** Get the cached listing of a directory in file system order.  */
+  std::vector<std::string> const&
+  GetDirectoryEntries(std::string const& dir);
+
   bool NoDefaultPath;
   bool NoCMakePath;
   bool NoCMakeEnvironmentPath;
@@ -350,7 +350,10 @@ bool cmFindLibraryHelper::CheckDirectoryForName(std::string const& path,
     {
     this->TestPath = path;
     this->TestPath += name.Raw;
-    if(cmSystemTools::FileExists(this->TestPath.c_str(), true))
+    if(this->GG->FileExistsInDirectory(
+         cmSystemTools::GetFilenamePath(this->TestPath),
+         cmSystemTools::GetFilenameName(this->TestPath)) &&
+       cmSystemTools::FileExists(this->TestPath.c_str(), true))
       {
       this->BestPath =
         cmSystemTools::CollapseFullPath(this->TestPath.c_str());
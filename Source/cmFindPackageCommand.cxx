@@ -10,11 +10,15 @@
   See the License for more information.
 ============================================================================*/
 #include "cmFindPackageCommand.h"
+#include "cmLocalGenerator.h"
+#include "cmGlobalGenerator.h"
 
 #include <cmsys/Directory.hxx>
 #include <cmsys/RegularExpression.hxx>
 #include <cmsys/Encoding.hxx>
 
+#include <time.h>
+
 #ifdef CMAKE_BUILD_WITH_CMAKE
 #include "cmVariableWatch.h"
 #endif
@@ -1511,7 +1515,8 @@ bool cmFindPackageCommand::FindConfigFile(std::string const& dir,
       {
       fprintf(stderr, "Checking file [%s]\n", file.c_str());
       }
-    if(cmSystemTools::FileExists(file.c_str(), true) &&
+    if(this->FileMayExist(file) &&
+       cmSystemTools::FileExists(file.c_str(), true) &&
        this->CheckVersion(file))
       {
       return true;
@@ -1534,7 +1539,7 @@ bool cmFindPackageCommand::CheckVersion(std::string const& config_file)
   // Look for foo-config-version.cmake
   std::string version_file = version_file_base;
   version_file += "-version.cmake";
-  if ((haveResult == false)
+  if ((haveResult == false) && this->FileMayExist(version_file)
        && (cmSystemTools::FileExists(version_file.c_str(), true)))
     {
     result = this->CheckVersionFile(version_file, version);
@@ -1544,7 +1549,7 @@ bool cmFindPackageCommand::CheckVersion(std::string const& config_file)
   // Look for fooConfigVersion.cmake
   version_file = version_file_base;
   version_file += "Version.cmake";
-  if ((haveResult == false)
+  if ((haveResult == false) && this->FileMayExist(version_file)
        && (cmSystemTools::FileExists(version_file.c_str(), true)))
     {
     result = this->CheckVersionFile(version_file, version);
@@ -1570,6 +1575,88 @@ bool cmFindPackageCommand::CheckVersion(std::string const& config_file)
 //----------------------------------------------------------------------------
 bool cmFindPackageCommand::CheckVersionFile(std::string const& version_file,
                                             std::string& result_version)
+{
+  // Version files produce the same result for the same inputs.  Key
+  // the cached result on the file content timestamp, the requested
+  // package and version, and the pointer size that generated version
+  // files compare against the package.
+  cmGlobalGenerator* gg =
+    this->Makefile->GetLocalGenerator()->GetGlobalGenerator();
+  long mtime = cmSystemTools::ModifiedTime(version_file.c_str());
+  cmOStringStream key;
+  key << version_file << "\n"
+      << mtime << "\n"
+      << this->Name << "\n"
+      << this->Version << "\n"
+      << this->Makefile->GetSafeDefinition("CMAKE_SIZEOF_VOID_P");
+  cmGlobalGenerator::PackageVersionResult pvr;
+  if(!gg->GetPackageVersionResult(key.str(), pvr))
+    {
+    if(!this->ReadVersionFile(version_file, pvr.Version, pvr.Exact,
+                              pvr.Compatible, pvr.Unsuitable))
+      {
+      result_version = "unknown";
+      return false;
+      }
+
+    // Modification times have a resolution of one second.  A file
+    // modified during the current second may change again without its
+    // time changing, so its result cannot be validated later.
+    if(mtime < static_cast<long>(time(0)))
+      {
+      gg->SetPackageVersionResult(key.str(), pvr);
+      }
+    }
+
+  // Check the output variables.
+  bool okay = pvr.Exact;
+  if(!okay && !this->VersionExact)
+    {
+    okay = pvr.Compatible;
+    }
+
+  // The package is suitable if the version is okay and not
+  // explicitly unsuitable.
+  bool suitable = !pvr.Unsuitable && (okay || this->Version.empty());
+  if(suitable)
+    {
+    // Get the version found.
+    this->VersionFound = pvr.Version;
+
+    // Try to parse the version number and store the results that were
+    // successfully parsed.
+    unsigned int parsed_major;
+    unsigned int parsed_minor;
+    unsigned int parsed_patch;
+    unsigned int parsed_tweak;
+    this->VersionFoundCount =
+      sscanf(this->VersionFound.c_str(), "%u.%u.%u.%u",
+             &parsed_major, &parsed_minor,
+             &parsed_patch, &parsed_tweak);
+    switch(this->VersionFoundCount)
+      {
+      case 4: this->VersionFoundTweak = parsed_tweak; // no break!
+      case 3: this->VersionFoundPatch = parsed_patch; // no break!
+      case 2: this->VersionFoundMinor = parsed_minor; // no break!
+      case 1: this->VersionFoundMajor = parsed_major; // no break!
+      default: break;
+      }
+    }
+
+  result_version = pvr.Version;
+  if (result_version.empty())
+    {
+    result_version = "unknown";
+    }
+
+  // Succeed if the version is suitable.
+  return suitable;
+}
+
+//----------------------------------------------------------------------------
+bool cmFindPackageCommand::ReadVersionFile(std::string const& version_file,
+                                           std::string& version, bool& exact,
+                                           bool& compatible, bool& unsuitable)
 {
   // The version file will be loaded in an isolated scope.
   cmMakefile::ScopePushPop varScope(this->Makefile);
@@ -1601,55 +1688,17 @@ bool cmFindPackageCommand::CheckVersionFile(std::string const& version_file,
 
   // Load the version check file.  Pass NoPolicyScope because we do
   // our own policy push/pop independent of CMP0011.
-  bool suitable = false;
-  if(this->ReadListFile(version_file.c_str(), NoPolicyScope))
-    {
-    // Check the output variables.
-    bool okay = this->Makefile->IsOn("PACKAGE_VERSION_EXACT");
-    bool unsuitable = this->Makefile->IsOn("PACKAGE_VERSION_UNSUITABLE");
-    if(!okay && !this->VersionExact)
-      {
-      okay = this->Makefile->IsOn("PACKAGE_VERSION_COMPATIBLE");
-      }
-
-    // The package is suitable if the version is okay and not
-    // explicitly unsuitable.
-    suitable = !unsuitable && (okay || this->Version.empty());
-    if(suitable)
-      {
-      // Get the version found.
-      this->VersionFound =
-        this->Makefile->GetSafeDefinition("PACKAGE_VERSION");
-
-      // Try to parse the version number and store the results that were
-      // successfully parsed.
-      unsigned int parsed_major;
-      unsigned int parsed_minor;
-      unsigned int parsed_patch;
-      unsigned int parsed_tweak;
-      this->VersionFoundCount =
-        sscanf(this->VersionFound.c_str(), "%u.%u.%u.%u",
-               &parsed_major, &parsed_minor,
-               &parsed_patch, &parsed_tweak);
-      switch(this->VersionFoundCount)
-        {
-        case 4: this->VersionFoundTweak = parsed_tweak; // no break!
-        case 3: this->VersionFoundPatch = parsed_patch; // no break!
-        case 2: this->VersionFoundMinor = parsed_minor; // no break!
-        case 1: this->VersionFoundMajor = parsed_major; // no break!
-        default: break;
-        }
-      }
-    }
-
-  result_version = this->Makefile->GetSafeDefinition("PACKAGE_VERSION");
-  if (result_version.empty())
+  if(!this->ReadListFile(version_file.c_str(), NoPolicyScope))
     {
-    result_version = "unknown";
+    return false;
     }
 
-  // Succeed if the version is suitable.
-  return suitable;
+  // Collect the output variables.
+  version = this->Makefile->GetSafeDefinition("PACKAGE_VERSION");
+  exact = this->Makefile->IsOn("PACKAGE_VERSION_EXACT");
+  compatible = this->Makefile->IsOn("PACKAGE_VERSION_COMPATIBLE");
+  unsuitable = this->Makefile->IsOn("PACKAGE_VERSION_UNSUITABLE");
+  return true;
 }
 
 //----------------------------------------------------------------------------
@@ -1693,6 +1742,8 @@ public:
   virtual ~cmFileListGeneratorBase() {}
 protected:
   bool Consider(std::string const& fullPath, cmFileList& listing);
+  std::vector<std::string> const&
+  GetDirectoryEntries(std::string const& parent, cmFileList& listing);
 private:
   bool Search(cmFileList&);
   virtual bool Search(std::string const& parent, cmFileList&) = 0;
@@ -1730,6 +1781,8 @@ public:
     }
 private:
   virtual bool Visit(std::string const& fullPath) = 0;
+  virtual std::vector<std::string> const&
+  GetDirectoryEntries(std::string const& dir) = 0;
   friend class cmFileListGeneratorBase;
   cmsys::auto_ptr<cmFileListGeneratorBase> First;
   cmFileListGeneratorBase* Last;
@@ -1753,6 +1806,11 @@ private:
       return this->FPC->CheckDirectory(fullPath);
       }
     }
+  std::vector<std::string> const&
+  GetDirectoryEntries(std::string const& dir)
+    {
+    return this->FPC->GetDirectoryEntries(dir);
+    }
   cmFindPackageCommand* FPC;
   bool UseSuffixes;
 };
@@ -1782,6 +1840,21 @@ bool cmFileListGeneratorBase::Consider(std::string const& fullPath,
     }
 }
 
+std::vector<std::string> const&
+cmFileListGeneratorBase::GetDirectoryEntries(std::string const& parent,
+                                             cmFileList& listing)
+{
+  // The listing is cached so that directories shared by many
+  // find_package calls are read from disk again only after they change.
+  // Callers copy the entries because considering one may reload them.
+  std::string dir = parent;
+  if(!dir.empty() && dir[dir.size()-1] == '/')
+    {
+    dir.erase(dir.size()-1);
+    }
+  return listing.GetDirectoryEntries(dir);
+}
+
 class cmFileListGeneratorFixed: public cmFileListGeneratorBase
 {
 public:
@@ -1846,16 +1919,12 @@ private:
     {
     // Construct a list of matches.
     std::vector<std::string> matches;
-    cmsys::Directory d;
-    d.Load(parent.c_str());
-    for(unsigned long i=0; i < d.GetNumberOfFiles(); ++i)
+    std::vector<std::string> files =
+      this->GetDirectoryEntries(parent, lister);
+    for(std::vector<std::string>::const_iterator fi = files.begin();
+        fi != files.end(); ++fi)
       {
-      const char* fname = d.GetFile(i);
-      if(strcmp(fname, ".") == 0 ||
-         strcmp(fname, "..") == 0)
-        {
-        continue;
-        }
+      const char* fname = fi->c_str();
       for(std::vector<std::string>::const_iterator ni = this->Names.begin();
           ni != this->Names.end(); ++ni)
         {
@@ -1900,16 +1969,12 @@ private:
     {
     // Construct a list of matches.
     std::vector<std::string> matches;
-    cmsys::Directory d;
-    d.Load(parent.c_str());
-    for(unsigned long i=0; i < d.GetNumberOfFiles(); ++i)
+    std::vector<std::string> files =
+      this->GetDirectoryEntries(parent, lister);
+    for(std::vector<std::string>::const_iterator fi = files.begin();
+        fi != files.end(); ++fi)
       {
-      const char* fname = d.GetFile(i);
-      if(strcmp(fname, ".") == 0 ||
-         strcmp(fname, "..") == 0)
-        {
-        continue;
-        }
+      const char* fname = fi->c_str();
       for(std::vector<std::string>::const_iterator ni = this->Names.begin();
           ni != this->Names.end(); ++ni)
         {
@@ -1953,17 +2018,12 @@ private:
   virtual bool Search(std::string const& parent, cmFileList& lister)
     {
     // Look for matching files.
-    std::vector<std::string> matches;
-    cmsys::Directory d;
-    d.Load(parent.c_str());
-    for(unsigned long i=0; i < d.GetNumberOfFiles(); ++i)
+    std::vector<std::string> files =
+      this->GetDirectoryEntries(parent, lister);
+    for(std::vector<std::string>::const_iterator fi = files.begin();
+        fi != files.end(); ++fi)
       {
-      const char* fname = d.GetFile(i);
-      if(strcmp(fname, ".") == 0 ||
-         strcmp(fname, "..") == 0)
-        {
-        continue;
-        }
+      const char* fname = fi->c_str();
       if(cmsysString_strcasecmp(fname, this->String.c_str()) == 0)
         {
         if(this->Consider(parent + fname, lister))
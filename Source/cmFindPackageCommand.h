@@ -89,6 +89,9 @@ private:
   bool CheckVersion(std::string const& config_file);
   bool CheckVersionFile(std::string const& version_file,
                         std::string& result_version);
+  bool ReadVersionFile(std::string const& version_file,
+                       std::string& version, bool& exact,
+                       bool& compatible, bool& unsuitable);
   bool SearchPrefix(std::string const& prefix);
   bool SearchFrameworkPrefix(std::string const& prefix_in);
   bool SearchAppBundlePrefix(std::string const& prefix_in);
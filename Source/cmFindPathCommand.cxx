@@ -160,7 +160,8 @@ std::string cmFindPathCommand::FindNormalHeader()
       {
       tryPath = *p;
       tryPath += *ni;
-      if(cmSystemTools::FileExists(tryPath.c_str()))
+      if(this->FileMayExist(tryPath) &&
+         cmSystemTools::FileExists(tryPath.c_str()))
         {
         if(this->IncludeFileInPath)
           {
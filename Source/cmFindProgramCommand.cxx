@@ -70,7 +70,7 @@ std::string cmFindProgramCommand::FindProgram(std::vector<std::string> names)
     }
   if(program.empty() && !this->SearchAppBundleOnly)
     {
-    program = cmSystemTools::FindProgram(names, this->SearchPaths, true);
+    program = this->FindNormalProgram(names);
     }
 
   if(program.empty() && this->SearchAppBundleLast)
@@ -80,6 +80,61 @@ std::string cmFindProgramCommand::FindProgram(std::vector<std::string> names)
   return program;
 }
 
+std::string cmFindProgramCommand
+::FindNormalProgram(std::vector<std::string> const& names)
+{
+  std::vector<std::string> noPaths;
+  for(std::vector<std::string>::const_iterator ni = names.begin();
+      ni != names.end() ; ++ni)
+    {
+    // Check the name as given first.
+    std::string program =
+      cmSystemTools::FindProgram(ni->c_str(), noPaths, true);
+    if(!program.empty())
+      {
+      return program;
+      }
+
+    // Consider the extensions the system adds to program names.
+    std::vector<std::string> extensions;
+#if defined (_WIN32) || defined(__CYGWIN__) || defined(__MINGW32__)
+    if(ni->size() <= 3 || (*ni)[ni->size()-4] != '.')
+      {
+      extensions.push_back(".com");
+      extensions.push_back(".exe");
+      }
+#endif
+    extensions.push_back("");
+
+    // Search every directory.  Directory listings are cached so each
+    // directory is read once instead of probed for every candidate.
+    for(std::vector<std::string>::const_iterator
+          p = this->SearchPaths.begin(); p != this->SearchPaths.end(); ++p)
+      {
+      for(std::vector<std::string>::const_iterator
+            ext = extensions.begin(); ext != extensions.end(); ++ext)
+        {
+        std::string tryPath = *p;
+#ifdef _WIN32
+        // Remove double quotes from the path on windows.
+        cmSystemTools::ReplaceString(tryPath, "\"", "");
+#endif
+        tryPath += *ni;
+        tryPath += *ext;
+        if(this->FileMayExist(tryPath) &&
+           cmSystemTools::FileExists(tryPath.c_str()) &&
+           !cmSystemTools::FileIsDirectory(tryPath.c_str()))
+          {
+          return cmSystemTools::CollapseFullPath(tryPath);
+          }
+        }
+      }
+    }
+
+  // Couldn't find the program.
+  return "";
+}
+
 std::string cmFindProgramCommand
 ::FindAppBundle(std::vector<std::string> names)
 {
@@ -40,6 +40,7 @@
 #include <stdlib.h> // required for atof
 
 #include <assert.h>
+#include <time.h>
 
 cmGlobalGenerator::cmGlobalGenerator()
 {
@@ -64,6 +65,8 @@ cmGlobalGenerator::cmGlobalGenerator()
   this->ExtraGenerator = 0;
   this->CurrentLocalGenerator = 0;
   this->TryCompileOuterMakefile = 0;
+
+  this->FileSystemGeneration = 0;
 }
 
 cmGlobalGenerator::~cmGlobalGenerator()
@@ -1481,6 +1484,9 @@ void cmGlobalGenerator::ClearGeneratorMembers()
   this->ProjectMap.clear();
   this->RuleHashes.clear();
   this->DirectoryContentMap.clear();
+  this->LibrarySONameMap.clear();
+  this->PackageVersionResults.clear();
+  this->GlobResults.clear();
   this->BinaryDirectories.clear();
 }
 
@@ -2679,16 +2685,51 @@ void cmGlobalGenerator::AddToManifest(const std::string& config,
   // Add to the content listing for the file's directory.
   std::string dir = cmSystemTools::GetFilenamePath(f);
   std::string file = cmSystemTools::GetFilenameName(f);
-  this->DirectoryContentMap[dir].insert(file);
+  DirectoryContent& dc = this->DirectoryContentMap[dir];
+  dc.insert(file);
+  dc.Generated.insert(file);
 }
 
 //----------------------------------------------------------------------------
 std::set<std::string> const&
 cmGlobalGenerator::GetDirectoryContent(std::string const& dir, bool needDisk)
+{
+  if(needDisk)
+    {
+    return this->LoadDirectoryContent(dir);
+    }
+  return this->DirectoryContentMap[dir];
+}
+
+//----------------------------------------------------------------------------
+cmGlobalGenerator::DirectoryContent&
+cmGlobalGenerator::LoadDirectoryContent(std::string const& dir)
 {
   DirectoryContent& dc = this->DirectoryContentMap[dir];
-  if(needDisk && !dc.LoadedFromDisk)
+
+  // Nothing can have changed the disk since the listing was last
+  // checked unless a command has run in the meantime.
+  if(dc.LoadedFromDisk && dc.Generation == this->FileSystemGeneration)
     {
+    return dc;
+    }
+  dc.Generation = this->FileSystemGeneration;
+
+  // Any change to the entries of a directory updates its modification
+  // time.  Reuse the listing only while that time has not changed.
+  long mtime = cmSystemTools::ModifiedTime(dir.c_str());
+  if(!dc.LoadedFromDisk || dc.DiskTime == -1 || dc.DiskTime != mtime)
+    {
+    // Modification times have a resolution of one second.  A directory
+    // modified during the current second may change again without its
+    // time changing, so such a listing must be loaded again after the
+    // next command.
+    dc.DiskTime = mtime < static_cast<long>(time(0))? mtime : -1;
+    dc.clear();
+    dc.OnDisk.clear();
+    dc.DiskOrder.clear();
+    dc.insert(dc.Generated.begin(), dc.Generated.end());
+
     // Load the directory content from disk.
     cmsys::Directory d;
     if(d.Load(dir.c_str()))
@@ -2700,6 +2741,12 @@ cmGlobalGenerator::GetDirectoryContent(std::string const& dir, bool needDisk)
         if(strcmp(f, ".") != 0 && strcmp(f, "..") != 0)
           {
           dc.insert(f);
+          dc.DiskOrder.push_back(f);
+#if defined(_WIN32) || defined(__APPLE__)
+          dc.OnDisk.insert(cmSystemTools::LowerCase(f));
+#else
+          dc.OnDisk.insert(f);
+#endif
           }
         }
       }
@@ -2708,6 +2755,122 @@ cmGlobalGenerator::GetDirectoryContent(std::string const& dir, bool needDisk)
   return dc;
 }
 
+//----------------------------------------------------------------------------
+std::vector<std::string> const&
+cmGlobalGenerator::GetDirectoryEntries(std::string const& dir)
+{
+  return this->LoadDirectoryContent(dir).DiskOrder;
+}
+
+//----------------------------------------------------------------------------
+bool cmGlobalGenerator::FileExistsInDirectory(std::string const& dir,
+                                              std::string const& name)
+{
+  DirectoryContent const& dc = this->LoadDirectoryContent(dir);
+#if defined(_WIN32) || defined(__APPLE__)
+  return dc.OnDisk.find(cmSystemTools::LowerCase(name)) != dc.OnDisk.end();
+#else
+  return dc.OnDisk.find(name) != dc.OnDisk.end();
+#endif
+}
+
+//----------------------------------------------------------------------------
+bool cmGlobalGenerator::GuessLibrarySOName(std::string const& fullPath,
+                                           std::string& soname)
+{
+  typedef std::map<std::string, LibrarySOName> LibrarySONameMapType;
+  LibrarySONameMapType::iterator i = this->LibrarySONameMap.find(fullPath);
+  if(i == this->LibrarySONameMap.end())
+    {
+    // Inspect the library file on disk only the first time it is seen.
+    LibrarySOName entry;
+    entry.Found = cmSystemTools::GuessLibrarySOName(fullPath, entry.SOName);
+    i = this->LibrarySONameMap.insert(
+      LibrarySONameMapType::value_type(fullPath, entry)).first;
+    }
+  if(i->second.Found)
+    {
+    soname = i->second.SOName;
+    }
+  return i->second.Found;
+}
+
+//----------------------------------------------------------------------------
+bool
+cmGlobalGenerator::GetPackageVersionResult(std::string const& key,
+                                           PackageVersionResult& result) const
+{
+  std::map<std::string, PackageVersionResult>::const_iterator i =
+    this->PackageVersionResults.find(key);
+  if(i == this->PackageVersionResults.end())
+    {
+    return false;
+    }
+  result = i->second;
+  return true;
+}
+
+//----------------------------------------------------------------------------
+void
+cmGlobalGenerator::SetPackageVersionResult(std::string const& key,
+                                           PackageVersionResult const& result)
+{
+  this->PackageVersionResults[key] = result;
+}
+
+//----------------------------------------------------------------------------
+bool cmGlobalGenerator::GetGlobResult(std::string const& key,
+                                      GlobResult& result)
+{
+  std::map<std::string, GlobResult>::iterator i = this->GlobResults.find(key);
+  if(i == this->GlobResults.end())
+    {
+    return false;
+    }
+
+  // Any change to the entries of a directory updates its modification
+  // time.  Drop the result if one of the directories read has changed.
+  for(std::vector<std::pair<std::string, long> >::const_iterator
+        di = i->second.Directories.begin();
+      di != i->second.Directories.end(); ++di)
+    {
+    if(cmSystemTools::ModifiedTime(di->first.c_str()) != di->second)
+      {
+      this->GlobResults.erase(i);
+      return false;
+      }
+    }
+  result = i->second;
+  return true;
+}
+
+//----------------------------------------------------------------------------
+void
+cmGlobalGenerator::SetGlobResult(std::string const& key,
+                                 std::vector<std::string> const& files,
+                                 unsigned int followedSymlinkCount,
+                                 std::vector<std::string> const& directories)
+{
+  // Modification times have a resolution of one second.  A directory
+  // modified during the current second may change again without its
+  // time changing, so such a result cannot be validated later.
+  long now = static_cast<long>(time(0));
+  GlobResult result;
+  for(std::vector<std::string>::const_iterator di = directories.begin();
+      di != directories.end(); ++di)
+    {
+    long mtime = cmSystemTools::ModifiedTime(di->c_str());
+    if(mtime >= now)
+      {
+      return;
+      }
+    result.Directories.push_back(std::make_pair(*di, mtime));
+    }
+  result.Files = files;
+  result.FollowedSymlinkCount = followedSymlinkCount;
+  this->GlobResults[key] = result;
+}
+
 //----------------------------------------------------------------------------
 void
 cmGlobalGenerator::AddRuleHash(const std::vector<std::string>& outputs,
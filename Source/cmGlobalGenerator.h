@@ -242,12 +242,70 @@ public:
     { return this->TargetManifest; }
 
   /** Get the content of a directory.  Directory listings are loaded
-      from disk at most once and cached.  During the generation step
-      the content will include the target files to be built even if
-      they do not yet exist.  */
+      from disk and cached until the directory is modified.  During the
+      generation step the content will include the target files to be
+      built even if they do not yet exist.  */
   std::set<std::string> const& GetDirectoryContent(std::string const& dir,
                                                    bool needDisk = true);
 
+  /** Get the names of the entries of a directory on disk in the order
+      the file system lists them.  This shares the cached listing used
+      by GetDirectoryContent.  */
+  std::vector<std::string> const&
+  GetDirectoryEntries(std::string const& dir);
+
+  /** Note that files on disk may have been changed.  A cached
+      directory listing is checked against the disk at most once
+      between two calls.  */
+  void FileSystemMayHaveChanged() { ++this->FileSystemGeneration; }
+
+  /** Check whether a file of the given name exists on disk in a
+      directory.  The check uses the cached directory listing so that
+      repeated queries for the same directory do not touch the disk.
+      The name is matched without case on platforms whose file
+      systems are typically case-insensitive.  */
+  bool FileExistsInDirectory(std::string const& dir,
+                             std::string const& name);
+
+  /** Guess the soname of a shared library as with
+      cmSystemTools::GuessLibrarySOName.  The result is cached so each
+      library file is inspected at most once per generate step.  */
+  bool GuessLibrarySOName(std::string const& fullPath, std::string& soname);
+
+  /** Output variables of a find_package version file evaluated for a
+      given set of inputs.  Results are cached for the configure step
+      so that repeated find_package calls do not re-run the file.  */
+  struct PackageVersionResult
+  {
+    std::string Version;
+    bool Exact;
+    bool Compatible;
+    bool Unsuitable;
+    PackageVersionResult(): Exact(false), Compatible(false),
+                            Unsuitable(false) {}
+  };
+  bool GetPackageVersionResult(std::string const& key,
+                               PackageVersionResult& result) const;
+  void SetPackageVersionResult(std::string const& key,
+                               PackageVersionResult const& result);
+
+  /** Files found by a file(GLOB) expression together with the
+      directories read to find them.  A result is reused during the
+      configure step only while none of those directories has been
+      modified.  */
+  struct GlobResult
+  {
+    std::vector<std::string> Files;
+    unsigned int FollowedSymlinkCount;
+    std::vector<std::pair<std::string, long> > Directories;
+    GlobResult(): FollowedSymlinkCount(0) {}
+  };
+  bool GetGlobResult(std::string const& key, GlobResult& result);
+  void SetGlobResult(std::string const& key,
+                     std::vector<std::string> const& files,
+                     unsigned int followedSymlinkCount,
+                     std::vector<std::string> const& directories);
+
   void AddTarget(cmTarget* t);
 
   static bool IsReservedTarget(std::string const& name);
@@ -457,16 +515,43 @@ private:
 
   virtual const char* GetBuildIgnoreErrorsFlag() const { return 0; }
 
-  // Cache directory content and target files to be built.
+  // Cache directory content and target files to be built.  A listing
+  // loaded from disk is reused only while the directory modification
+  // time recorded with it, or -1 if none could be trusted, is current.
+  // The time is checked once per file system generation.
   struct DirectoryContent: public std::set<std::string>
   {
     typedef std::set<std::string> derived;
     bool LoadedFromDisk;
-    DirectoryContent(): LoadedFromDisk(false) {}
+    long DiskTime;
+    unsigned long Generation;
+    std::set<std::string> OnDisk;
+    std::vector<std::string> DiskOrder;
+    std::set<std::string> Generated;
+    DirectoryContent(): LoadedFromDisk(false), DiskTime(-1), Generation(0) {}
     DirectoryContent(DirectoryContent const& dc):
-      derived(dc), LoadedFromDisk(dc.LoadedFromDisk) {}
+      derived(dc), LoadedFromDisk(dc.LoadedFromDisk),
+      DiskTime(dc.DiskTime), Generation(dc.Generation),
+      OnDisk(dc.OnDisk), DiskOrder(dc.DiskOrder), Generated(dc.Generated) {}
   };
   std::map<std::string, DirectoryContent> DirectoryContentMap;
+  DirectoryContent& LoadDirectoryContent(std::string const& dir);
+  unsigned long FileSystemGeneration;
+
+  // Cache library sonames guessed from files on disk.
+  struct LibrarySOName
+  {
+    bool Found;
+    std::string SOName;
+    LibrarySOName(): Found(false) {}
+  };
+  std::map<std::string, LibrarySOName> LibrarySONameMap;
+
+  // Cache find_package version file results.
+  std::map<std::string, PackageVersionResult> PackageVersionResults;
+
+  // Cache file(GLOB) results.
+  std::map<std::string, GlobResult> GlobResults;
 
   // Set of binary directories on disk.
   std::set<std::string> BinaryDirectories;
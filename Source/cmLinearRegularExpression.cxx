@@ -0,0 +1,793 @@
+/*============================================================================
+  CMake - Cross Platform Makefile Generator
+  Copyright 2000-2009 Kitware, Inc., Insight Software Consortium
+
+  Distributed under the OSI-approved BSD License (the "License");
+  see accompanying file Copyright.txt for details.
+
+  This software is distributed WITHOUT ANY WARRANTY; without even the
+  implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+  See the License for more information.
+============================================================================*/
+#include "cmLinearRegularExpression.h"
+
+#include <cmsys/RegularExpression.hxx>
+#include <cmsys/stl/algorithm>
+
+//----------------------------------------------------------------------------
+class cmLinearRegularExpressionCompiler
+{
+public:
+  typedef cmLinearRegularExpression RegEx;
+  cmLinearRegularExpressionCompiler(RegEx& regex, const char* exp):
+    Regex(regex), Parse(exp), Groups(0), Failed(false) {}
+
+  bool Compile();
+  int GetGroups() const { return this->Groups; }
+
+private:
+  // The expression is parsed into a tree and then emitted as a program.
+  enum NodeType
+  {
+    NodeEmpty,
+    NodeChar,
+    NodeAny,
+    NodeSet,
+    NodeBol,
+    NodeEol,
+    NodeGroup,
+    NodeConcat,
+    NodeAlt,
+    NodeStar,
+    NodePlus,
+    NodeQuest
+  };
+  struct Node
+  {
+    int Type;
+    int Arg;
+    int Left;
+    int Right;
+  };
+  std::vector<Node> Nodes;
+
+  RegEx& Regex;
+  const char* Parse;
+  int Groups;
+  bool Failed;
+
+  int NewNode(int type, int arg = 0, int left = -1, int right = -1);
+  int Fail();
+  int ParseAlt();
+  int ParseBranch();
+  int ParsePiece();
+  int ParseAtom();
+  int ParseSet();
+  int Emit(int op, int arg = 0, int x = -1, int y = -1);
+  void EmitNode(int node);
+};
+
+//----------------------------------------------------------------------------
+int cmLinearRegularExpressionCompiler::NewNode(int type, int arg,
+                                               int left, int right)
+{
+  Node n;
+  n.Type = type;
+  n.Arg = arg;
+  n.Left = left;
+  n.Right = right;
+  this->Nodes.push_back(n);
+  return static_cast<int>(this->Nodes.size()) - 1;
+}
+
+//----------------------------------------------------------------------------
+int cmLinearRegularExpressionCompiler::Fail()
+{
+  this->Failed = true;
+  return this->NewNode(NodeEmpty);
+}
+
+//----------------------------------------------------------------------------
+int cmLinearRegularExpressionCompiler::ParseAlt()
+{
+  int node = this->ParseBranch();
+  while(!this->Failed && *this->Parse == '|')
+    {
+    ++this->Parse;
+    node = this->NewNode(NodeAlt, 0, node, this->ParseBranch());
+    }
+  return node;
+}
+
+//----------------------------------------------------------------------------
+int cmLinearRegularExpressionCompiler::ParseBranch()
+{
+  int node = this->NewNode(NodeEmpty);
+  while(!this->Failed && *this->Parse &&
+        *this->Parse != '|' && *this->Parse != ')')
+    {
+    node = this->NewNode(NodeConcat, 0, node, this->ParsePiece());
+    }
+  return node;
+}
+
+//----------------------------------------------------------------------------
+int cmLinearRegularExpressionCompiler::ParsePiece()
+{
+  int atom = this->ParseAtom();
+  switch(*this->Parse)
+    {
+    case '*':
+      ++this->Parse;
+      return this->NewNode(NodeStar, 0, atom);
+    case '+':
+      ++this->Parse;
+      return this->NewNode(NodePlus, 0, atom);
+    case '?':
+      ++this->Parse;
+      return this->NewNode(NodeQuest, 0, atom);
+    default:
+      return atom;
+    }
+}
+
+//----------------------------------------------------------------------------
+int cmLinearRegularExpressionCompiler::ParseAtom()
+{
+  // Follow the syntax accepted by cmsys::RegularExpression.
+  char c = *this->Parse++;
+  switch(c)
+    {
+    case '^':
+      return this->NewNode(NodeBol);
+    case '$':
+      return this->NewNode(NodeEol);
+    case '.':
+      return this->NewNode(NodeAny);
+    case '[':
+      return this->ParseSet();
+    case '(':
+      {
+      int group = ++this->Groups;
+      if(group >= RegEx::NSUBEXP)
+        {
+        return this->Fail();
+        }
+      int inner = this->ParseAlt();
+      if(*this->Parse != ')')
+        {
+        return this->Fail();
+        }
+      ++this->Parse;
+      return this->NewNode(NodeGroup, group, inner);
+      }
+    case '\\':
+      c = *this->Parse++;
+      if(!c)
+        {
+        return this->Fail();
+        }
+      return this->NewNode(NodeChar, static_cast<unsigned char>(c));
+    case '\0': case '|': case ')': case '*': case '+': case '?':
+      return this->Fail();
+    default:
+      return this->NewNode(NodeChar, static_cast<unsigned char>(c));
+    }
+}
+
+//----------------------------------------------------------------------------
+int cmLinearRegularExpressionCompiler::ParseSet()
+{
+  RegEx::CharSet set;
+  for(int i = 0; i < 256; ++i)
+    {
+    set.Has[i] = false;
+    }
+  bool negate = false;
+  if(*this->Parse == '^')
+    {
+    negate = true;
+    ++this->Parse;
+    }
+  if(*this->Parse == ']' || *this->Parse == '-')
+    {
+    set.Has[static_cast<unsigned char>(*this->Parse++)] = true;
+    }
+  while(*this->Parse && *this->Parse != ']')
+    {
+    if(*this->Parse == '-')
+      {
+      ++this->Parse;
+      if(*this->Parse == ']' || *this->Parse == '\0')
+        {
+        set.Has[static_cast<unsigned char>('-')] = true;
+        }
+      else
+        {
+        int first = static_cast<unsigned char>(this->Parse[-2]) + 1;
+        int last = static_cast<unsigned char>(*this->Parse++);
+        for(; first <= last; ++first)
+          {
+          set.Has[first] = true;
+          }
+        }
+      }
+    else
+      {
+      set.Has[static_cast<unsigned char>(*this->Parse++)] = true;
+      }
+    }
+  if(*this->Parse != ']')
+    {
+    return this->Fail();
+    }
+  ++this->Parse;
+  if(negate)
+    {
+    for(int i = 0; i < 256; ++i)
+      {
+      set.Has[i] = !set.Has[i];
+      }
+    }
+  // The end of the string never matches.
+  set.Has[0] = false;
+  this->Regex.Sets.push_back(set);
+  return this->NewNode(NodeSet,
+                       static_cast<int>(this->Regex.Sets.size()) - 1);
+}
+
+//----------------------------------------------------------------------------
+int cmLinearRegularExpressionCompiler::Emit(int op, int arg, int x, int y)
+{
+  RegEx::Instruction inst;
+  inst.Op = op;
+  inst.Arg = arg;
+  inst.X = x;
+  inst.Y = y;
+  this->Regex.Program.push_back(inst);
+  return static_cast<int>(this->Regex.Program.size()) - 1;
+}
+
+//----------------------------------------------------------------------------
+void cmLinearRegularExpressionCompiler::EmitNode(int index)
+{
+  Node const& node = this->Nodes[index];
+  std::vector<RegEx::Instruction>& prog = this->Regex.Program;
+  switch(node.Type)
+    {
+    case NodeEmpty:
+      break;
+    case NodeChar:
+      this->Emit(RegEx::OpChar, node.Arg);
+      break;
+    case NodeAny:
+      this->Emit(RegEx::OpAny);
+      break;
+    case NodeSet:
+      this->Emit(RegEx::OpSet, node.Arg);
+      break;
+    case NodeBol:
+      this->Emit(RegEx::OpBol);
+      break;
+    case NodeEol:
+      this->Emit(RegEx::OpEol);
+      break;
+    case NodeGroup:
+      this->Emit(RegEx::OpSave, 2*node.Arg);
+      this->EmitNode(node.Left);
+      this->Emit(RegEx::OpSave, 2*node.Arg+1);
+      break;
+    case NodeConcat:
+      this->EmitNode(node.Left);
+      this->EmitNode(node.Right);
+      break;
+    case NodeAlt:
+      {
+      // Prefer the left alternative, as the backtracking engine does.
+      int split = this->Emit(RegEx::OpSplit);
+      prog[split].X = static_cast<int>(prog.size());
+      this->EmitNode(node.Left);
+      int jump = this->Emit(RegEx::OpJump);
+      prog[split].Y = static_cast<int>(prog.size());
+      this->EmitNode(node.Right);
+      prog[jump].X = static_cast<int>(prog.size());
+      }
+      break;
+    case NodeStar:
+      {
+      // Repetition is greedy: prefer another iteration.
+      int split = this->Emit(RegEx::OpSplit);
+      prog[split].X = static_cast<int>(prog.size());
+      this->EmitNode(node.Left);
+      this->Emit(RegEx::OpJump, 0, split);
+      prog[split].Y = static_cast<int>(prog.size());
+      }
+      break;
+    case NodePlus:
+      {
+      int loop = static_cast<int>(prog.size());
+      this->EmitNode(node.Left);
+      int split = this->Emit(RegEx::OpSplit, 0, loop);
+      prog[split].Y = static_cast<int>(prog.size());
+      }
+      break;
+    case NodeQuest:
+      {
+      int split = this->Emit(RegEx::OpSplit);
+      prog[split].X = static_cast<int>(prog.size());
+      this->EmitNode(node.Left);
+      prog[split].Y = static_cast<int>(prog.size());
+      }
+      break;
+    }
+}
+
+//----------------------------------------------------------------------------
+bool cmLinearRegularExpressionCompiler::Compile()
+{
+  int root = this->ParseAlt();
+  if(this->Failed || *this->Parse)
+    {
+    return false;
+    }
+  this->Emit(RegEx::OpSave, 0);
+  this->EmitNode(root);
+  this->Emit(RegEx::OpSave, 1);
+  this->Emit(RegEx::OpMatch);
+  return true;
+}
+
+//----------------------------------------------------------------------------
+cmLinearRegularExpression::cmLinearRegularExpression()
+{
+  this->Initialize();
+}
+
+//----------------------------------------------------------------------------
+cmLinearRegularExpression::cmLinearRegularExpression(const char* s)
+{
+  this->Initialize();
+  if(s)
+    {
+    this->compile(s);
+    }
+}
+
+//----------------------------------------------------------------------------
+cmLinearRegularExpression::cmLinearRegularExpression(std::string const& s)
+{
+  this->Initialize();
+  this->compile(s.c_str());
+}
+
+//----------------------------------------------------------------------------
+void cmLinearRegularExpression::Initialize()
+{
+  this->NumCaps = 0;
+  this->MayBeEmpty = true;
+  this->SearchString = 0;
+  for(int i = 0; i < NSUBEXP; ++i)
+    {
+    this->StartP[i] = 0;
+    this->EndP[i] = 0;
+    }
+  this->Lists[0].Generation = 0;
+  this->Lists[1].Generation = 0;
+}
+
+//----------------------------------------------------------------------------
+bool cmLinearRegularExpression::compile(const char* s)
+{
+  this->Program.clear();
+  this->Sets.clear();
+
+  // Let the backtracking engine check the syntax so that both accept
+  // exactly the same expressions and report errors the same way.
+  cmsys::RegularExpression check;
+  if(!check.compile(s))
+    {
+    return false;
+    }
+
+  cmLinearRegularExpressionCompiler compiler(*this, s);
+  if(!compiler.Compile())
+    {
+    this->Program.clear();
+    this->Sets.clear();
+    return false;
+    }
+  this->NumCaps = 2 * (compiler.GetGroups() + 1);
+  this->ComputeFirst();
+  return true;
+}
+
+//----------------------------------------------------------------------------
+void cmLinearRegularExpression::ComputeFirst()
+{
+  // Follow the empty transitions from the start of the program to find
+  // the characters that can begin a match somewhere after the start of
+  // the string.  There '^' cannot match, and '$' can match only at the
+  // end, which find() always reaches.
+  for(int i = 0; i < 256; ++i)
+    {
+    this->First[i] = false;
+    }
+  this->MayBeEmpty = false;
+  std::vector<bool> seen(this->Program.size(), false);
+  std::vector<int> todo(1, 0);
+  while(!todo.empty())
+    {
+    int pc = todo.back();
+    todo.pop_back();
+    if(seen[pc])
+      {
+      continue;
+      }
+    seen[pc] = true;
+    Instruction const& inst = this->Program[pc];
+    switch(inst.Op)
+      {
+      case OpChar:
+        this->First[inst.Arg] = true;
+        break;
+      case OpAny:
+        for(int i = 1; i < 256; ++i)
+          {
+          this->First[i] = true;
+          }
+        break;
+      case OpSet:
+        for(int i = 0; i < 256; ++i)
+          {
+          this->First[i] = this->First[i] || this->Sets[inst.Arg].Has[i];
+          }
+        break;
+      case OpSplit:
+        todo.push_back(inst.Y);
+        todo.push_back(inst.X);
+        break;
+      case OpJump:
+        todo.push_back(inst.X);
+        break;
+      case OpSave:
+        todo.push_back(pc+1);
+        break;
+      case OpMatch:
+        this->MayBeEmpty = true;
+        break;
+      case OpBol:
+      case OpEol:
+        break;
+      }
+    }
+}
+
+//----------------------------------------------------------------------------
+void cmLinearRegularExpression::ClearList(ThreadList& list, size_t size)
+{
+  list.PC.clear();
+  list.Caps.clear();
+  if(list.Mark.size() != size || ++list.Generation == 0)
+    {
+    list.Mark.assign(size, 0);
+    list.Generation = 1;
+    }
+}
+
+//----------------------------------------------------------------------------
+void cmLinearRegularExpression::AddThread(ThreadList& list, int pc,
+                                          const char** caps,
+                                          const char* sp)
+{
+  if(list.Mark[pc] == list.Generation)
+    {
+    // A thread of higher priority already reached this instruction here.
+    return;
+    }
+  list.Mark[pc] = list.Generation;
+  Instruction const& inst = this->Program[pc];
+  switch(inst.Op)
+    {
+    case OpJump:
+      this->AddThread(list, inst.X, caps, sp);
+      break;
+    case OpSplit:
+      this->AddThread(list, inst.X, caps, sp);
+      this->AddThread(list, inst.Y, caps, sp);
+      break;
+    case OpSave:
+      {
+      const char* old = caps[inst.Arg];
+      caps[inst.Arg] = sp;
+      this->AddThread(list, pc+1, caps, sp);
+      caps[inst.Arg] = old;
+      }
+      break;
+    case OpBol:
+      if(sp == this->SearchString)
+        {
+        this->AddThread(list, pc+1, caps, sp);
+        }
+      break;
+    case OpEol:
+      if(!*sp)
+        {
+        this->AddThread(list, pc+1, caps, sp);
+        }
+      break;
+    default:
+      list.PC.push_back(pc);
+      list.Caps.insert(list.Caps.end(), caps, caps + this->NumCaps);
+      break;
+    }
+}
+
+//----------------------------------------------------------------------------
+bool cmLinearRegularExpression::find(const char* s)
+{
+  this->SearchString = s;
+  for(int i = 0; i < NSUBEXP; ++i)
+    {
+    this->StartP[i] = 0;
+    this->EndP[i] = 0;
+    }
+  if(this->Program.empty())
+    {
+    return false;
+    }
+
+  size_t len = strlen(s);
+  if(len <= this->backtrack_limit())
+    {
+    return this->FindBacktrack(s, len);
+    }
+  return this->FindThreads(s);
+}
+
+//----------------------------------------------------------------------------
+std::string::size_type cmLinearRegularExpression::backtrack_limit() const
+{
+  // Use the backtracker when its table of tried pairs, one bit for each
+  // instruction at each position, fits in 32KiB.
+  size_t const maxBits = 256 * 1024;
+  if(this->Program.empty() || this->Program.size() > maxBits)
+    {
+    return 0;
+    }
+  return maxBits / this->Program.size() - 1;
+}
+
+//----------------------------------------------------------------------------
+bool cmLinearRegularExpression::FindBacktrack(const char* s, size_t len)
+{
+  size_t bits = this->Program.size() * (len + 1);
+  size_t words = (bits + 31) / 32;
+  if(this->Visited.size() < words)
+    {
+    this->Visited.resize(words);
+    }
+  std::fill(this->Visited.begin(), this->Visited.begin() + words, 0u);
+
+  // Whether a pair failed does not depend on where the attempt started,
+  // so the table is kept across starting positions.  Past the first
+  // position, start only where a match can begin, or at the end where
+  // '$' may match.
+  const char* caps[2*NSUBEXP];
+  for(int i = 0; i < 2*NSUBEXP; ++i)
+    {
+    caps[i] = 0;
+    }
+  for(const char* sp = s; ; ++sp)
+    {
+    if(sp == s || !*sp || this->MayBeEmpty ||
+       this->First[static_cast<unsigned char>(*sp)])
+      {
+      if(this->TryBacktrack(sp, len, caps))
+        {
+        return true;
+        }
+      }
+    if(!*sp)
+      {
+      break;
+      }
+    }
+  return false;
+}
+
+//----------------------------------------------------------------------------
+bool cmLinearRegularExpression::TryBacktrack(const char* start, size_t len,
+                                             const char** caps)
+{
+  const char* s = this->SearchString;
+  this->Jobs.clear();
+  Job first = { 0, -1, start };
+  this->Jobs.push_back(first);
+  while(!this->Jobs.empty())
+    {
+    Job job = this->Jobs.back();
+    this->Jobs.pop_back();
+    if(job.Slot >= 0)
+      {
+      // Undo a capture made on the path that failed.
+      caps[job.Slot] = job.SP;
+      continue;
+      }
+    int pc = job.PC;
+    const char* sp = job.SP;
+    for(;;)
+      {
+      size_t bit = static_cast<size_t>(pc) * (len + 1) +
+        static_cast<size_t>(sp - s);
+      unsigned int& word = this->Visited[bit / 32];
+      unsigned int mask = 1u << (bit % 32);
+      if(word & mask)
+        {
+        break;
+        }
+      word |= mask;
+
+      Instruction const& inst = this->Program[pc];
+      unsigned char c = static_cast<unsigned char>(*sp);
+      bool ok = true;
+      switch(inst.Op)
+        {
+        case OpChar:
+          ok = c == inst.Arg;
+          ++sp;
+          ++pc;
+          break;
+        case OpAny:
+          ok = c != 0;
+          ++sp;
+          ++pc;
+          break;
+        case OpSet:
+          ok = this->Sets[inst.Arg].Has[c];
+          ++sp;
+          ++pc;
+          break;
+        case OpSplit:
+          {
+          Job alt = { inst.Y, -1, sp };
+          this->Jobs.push_back(alt);
+          pc = inst.X;
+          }
+          break;
+        case OpJump:
+          pc = inst.X;
+          break;
+        case OpSave:
+          {
+          Job undo = { 0, inst.Arg, caps[inst.Arg] };
+          this->Jobs.push_back(undo);
+          caps[inst.Arg] = sp;
+          ++pc;
+          }
+          break;
+        case OpBol:
+          ok = sp == s;
+          ++pc;
+          break;
+        case OpEol:
+          ok = c == 0;
+          ++pc;
+          break;
+        case OpMatch:
+          for(int i = 0; i < NSUBEXP; ++i)
+            {
+            this->StartP[i] = caps[2*i];
+            this->EndP[i] = caps[2*i+1];
+            }
+          return true;
+        }
+      if(!ok)
+        {
+        break;
+        }
+      }
+    }
+  return false;
+}
+
+//----------------------------------------------------------------------------
+bool cmLinearRegularExpression::FindThreads(const char* s)
+{
+  size_t size = this->Program.size();
+  ThreadList* clist = &this->Lists[0];
+  ThreadList* nlist = &this->Lists[1];
+  ClearList(*clist, size);
+
+  const char* caps[2*NSUBEXP];
+  const char* best[2*NSUBEXP];
+  for(int i = 0; i < 2*NSUBEXP; ++i)
+    {
+    caps[i] = 0;
+    best[i] = 0;
+    }
+  bool matched = false;
+
+  const char* sp = s;
+  for(;;)
+    {
+    // Until a match is found, start a new thread at each position with
+    // lower priority than those already running.
+    if(!matched)
+      {
+      if(clist->PC.empty() && sp != s && !this->MayBeEmpty)
+        {
+        // No thread is running, so skip to a character that can start
+        // a match.
+        while(*sp && !this->First[static_cast<unsigned char>(*sp)])
+          {
+          ++sp;
+          }
+        ClearList(*clist, size);
+        }
+      this->AddThread(*clist, 0, caps, sp);
+      }
+    if(clist->PC.empty())
+      {
+      if(matched || !*sp)
+        {
+        break;
+        }
+      ClearList(*clist, size);
+      ++sp;
+      continue;
+      }
+
+    unsigned char c = static_cast<unsigned char>(*sp);
+    ClearList(*nlist, size);
+    for(size_t i = 0; i < clist->PC.size(); ++i)
+      {
+      int pc = clist->PC[i];
+      Instruction const& inst = this->Program[pc];
+      const char** tcaps = &clist->Caps[i * this->NumCaps];
+      if(inst.Op == OpMatch)
+        {
+        // Threads after this one have lower priority.  Drop them.
+        matched = true;
+        for(int k = 0; k < this->NumCaps; ++k)
+          {
+          best[k] = tcaps[k];
+          }
+        break;
+        }
+      if((inst.Op == OpChar && c == inst.Arg) ||
+         (inst.Op == OpAny && c) ||
+         (inst.Op == OpSet && this->Sets[inst.Arg].Has[c]))
+        {
+        this->AddThread(*nlist, pc+1, tcaps, sp+1);
+        }
+      }
+    ThreadList* tmp = clist;
+    clist = nlist;
+    nlist = tmp;
+    if(!c)
+      {
+      break;
+      }
+    ++sp;
+    }
+
+  if(matched)
+    {
+    for(int i = 0; i < NSUBEXP; ++i)
+      {
+      this->StartP[i] = best[2*i];
+      this->EndP[i] = best[2*i+1];
+      }
+    }
+  return matched;
+}
+
+//----------------------------------------------------------------------------
+std::string cmLinearRegularExpression::match(int n) const
+{
+  if(!this->StartP[n])
+    {
+    return "";
+    }
+  return std::string(this->StartP[n], this->EndP[n] - this->StartP[n]);
+}
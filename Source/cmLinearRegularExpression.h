@@ -0,0 +1,159 @@
+/*============================================================================
+  CMake - Cross Platform Makefile Generator
+  Copyright 2000-2009 Kitware, Inc., Insight Software Consortium
+
+  Distributed under the OSI-approved BSD License (the "License");
+  see accompanying file Copyright.txt for details.
+
+  This software is distributed WITHOUT ANY WARRANTY; without even the
+  implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+  See the License for more information.
+============================================================================*/
+#ifndef cmLinearRegularExpression_h
+#define cmLinearRegularExpression_h
+
+#include "cmStandardIncludes.h"
+
+/** \class cmLinearRegularExpression
+ * \brief Regular expression matcher that runs in linear time.
+ *
+ * This class accepts the same syntax as cmsys::RegularExpression and
+ * finds the same match and sub-expressions.  It has the same interface,
+ * so a call site can switch engines by changing the declared type.
+ *
+ * It does not backtrack.  The expression is compiled to a Thompson NFA
+ * and all alternatives are simulated together, as in Pike's VM, with
+ * priorities that give the same leftmost result as the backtracking
+ * engine.  Time is bounded by the length of the input times the size of
+ * the expression, so expressions with nested repetition cannot blow up.
+ * While no alternative is active, the matcher skips ahead to the next
+ * character that can start a match.
+ *
+ * Short inputs, such as single lines, are instead searched by a
+ * backtracker that records each instruction and position it has tried.
+ * It finds the same match with less bookkeeping per character, and
+ * never tries a pair twice, so it is also linear.
+ */
+class cmLinearRegularExpression
+{
+public:
+  cmLinearRegularExpression();
+  cmLinearRegularExpression(const char* s);
+  cmLinearRegularExpression(std::string const& s);
+
+  /**
+   * Compile a regular expression.  Returns false and leaves the object
+   * invalid if the expression is not accepted by cmsys::RegularExpression.
+   */
+  bool compile(const char* s);
+  bool compile(std::string const& s) { return this->compile(s.c_str()); }
+
+  /**
+   * Search the given string for the leftmost match.  Returns true if
+   * found, and sets start and end indexes accordingly.
+   */
+  bool find(const char* s);
+  bool find(std::string const& s) { return this->find(s.c_str()); }
+
+  /** Index to start and end of the match found by the last find().  */
+  std::string::size_type start() const { return this->start(0); }
+  std::string::size_type end() const { return this->end(0); }
+
+  /** Index to start and end of the nth sub-expression.  The 0th is the
+      whole match.  */
+  std::string::size_type start(int n) const
+    {
+    return static_cast<std::string::size_type>(
+      this->StartP[n] - this->SearchString);
+    }
+  std::string::size_type end(int n) const
+    {
+    return static_cast<std::string::size_type>(
+      this->EndP[n] - this->SearchString);
+    }
+
+  /** Text of the nth sub-expression, or empty if it did not match.  */
+  std::string match(int n) const;
+
+  /** Length of the longest input that find() searches with the
+      backtracker.  Longer inputs are searched by simulating all
+      alternatives at once.  */
+  std::string::size_type backtrack_limit() const;
+
+  /** Whether an expression has been compiled successfully.  */
+  bool is_valid() const { return !this->Program.empty(); }
+  void set_invalid() { this->Program.clear(); }
+
+  enum { NSUBEXP = 10 };
+
+private:
+  enum Opcode
+  {
+    OpChar,   // Match the character in Arg.
+    OpAny,    // Match any character.
+    OpSet,    // Match a character in set number Arg.
+    OpSplit,  // Continue at X, then at lower priority at Y.
+    OpJump,   // Continue at X.
+    OpSave,   // Record the position in capture slot Arg.
+    OpBol,    // Match the beginning of the string.
+    OpEol,    // Match the end of the string.
+    OpMatch   // Report a match.
+  };
+  struct Instruction
+  {
+    int Op;
+    int Arg;
+    int X;
+    int Y;
+  };
+  struct CharSet
+  {
+    bool Has[256];
+  };
+  std::vector<Instruction> Program;
+  std::vector<CharSet> Sets;
+
+  // Number of capture slots in use: a start and end per sub-expression.
+  int NumCaps;
+
+  // Characters that may begin a match, and whether a match may be empty.
+  bool First[256];
+  bool MayBeEmpty;
+
+  const char* SearchString;
+  const char* StartP[NSUBEXP];
+  const char* EndP[NSUBEXP];
+
+  // Thread lists reused between calls to find().
+  struct ThreadList
+  {
+    std::vector<int> PC;
+    std::vector<const char*> Caps;
+    std::vector<unsigned int> Mark;
+    unsigned int Generation;
+  };
+  ThreadList Lists[2];
+
+  // Instruction and position pairs tried by the backtracker, one bit
+  // each, and its stack of pending alternatives.
+  struct Job
+  {
+    int PC;
+    int Slot;
+    const char* SP;
+  };
+  std::vector<unsigned int> Visited;
+  std::vector<Job> Jobs;
+
+  friend class cmLinearRegularExpressionCompiler;
+  void Initialize();
+  void ComputeFirst();
+  static void ClearList(ThreadList& list, size_t size);
+  void AddThread(ThreadList& list, int pc, const char** caps,
+                 const char* sp);
+  bool FindBacktrack(const char* s, size_t len);
+  bool TryBacktrack(const char* start, size_t len, const char** caps);
+  bool FindThreads(const char* s);
+};
+
+#endif
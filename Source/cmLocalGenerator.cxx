@@ -468,33 +468,21 @@ void cmLocalGenerator::GenerateInstallRules()
     "endif()\n"
     "\n";
 
-  // Copy user-specified install options to the install code.
-  if(const char* so_no_exe =
-     this->Makefile->GetDefinition("CMAKE_INSTALL_SO_NO_EXE"))
-    {
-    fout <<
-      "# Install shared libraries without execute permission?\n"
-      "if(NOT DEFINED CMAKE_INSTALL_SO_NO_EXE)\n"
-      "  set(CMAKE_INSTALL_SO_NO_EXE \"" << so_no_exe << "\")\n"
-      "endif()\n"
-      "\n";
-    }
+  // Write the install rules of this directory.
+  this->GenerateDirectoryInstallRules(fout);
 
-  // Ask each install generator to write its code.
-  std::vector<cmInstallGenerator*> const& installers =
-    this->Makefile->GetInstallGenerators();
-  for(std::vector<cmInstallGenerator*>::const_iterator
-        gi = installers.begin();
-      gi != installers.end(); ++gi)
+  // Write the rules of all subdirectories into the top-level script
+  // instead of including one script per directory, if requested.
+  if(toplevel_install && !this->Children.empty() &&
+     this->Makefile->IsOn("CMAKE_INSTALL_FLATTEN_SCRIPTS"))
     {
-    (*gi)->Generate(fout, config, configurationTypes);
+    fout << "if(NOT CMAKE_INSTALL_LOCAL_ONLY)\n\n";
+    this->GenerateSubdirectoryInstallRules(fout);
+    fout << "endif()\n\n";
     }
 
-  // Write rules from old-style specification stored in targets.
-  this->GenerateTargetInstallRules(fout, config, configurationTypes);
-
   // Include install scripts from subdirectories.
-  if(!this->Children.empty())
+  else if(!this->Children.empty())
     {
     fout << "if(NOT CMAKE_INSTALL_LOCAL_ONLY)\n";
     fout << "  # Include the install script for each subdirectory.\n";
@@ -520,8 +508,11 @@ void cmLocalGenerator::GenerateInstallRules()
       "if(CMAKE_INSTALL_COMPONENT)\n"
       "  set(CMAKE_INSTALL_MANIFEST \"install_manifest_"
       "${CMAKE_INSTALL_COMPONENT}.txt\")\n"
+      "  set(CMAKE_INSTALL_MANIFEST_HASHES \"install_manifest_"
+      "${CMAKE_INSTALL_COMPONENT}.hashes\")\n"
       "else()\n"
       "  set(CMAKE_INSTALL_MANIFEST \"install_manifest.txt\")\n"
+      "  set(CMAKE_INSTALL_MANIFEST_HASHES \"install_manifest.hashes\")\n"
       "endif()\n\n";
     fout
       << "file(WRITE \""
@@ -533,6 +524,92 @@ void cmLocalGenerator::GenerateInstallRules()
       << homedir << "/${CMAKE_INSTALL_MANIFEST}\" "
       << "\"${file}\\n\")" << std::endl
       << "endforeach()" << std::endl;
+
+    // Record the size, time and content hash of each installed file
+    // when requested.  This reads every file that changed.
+    const char* recordHashes =
+      this->Makefile->IsOn("CMAKE_INSTALL_RECORD_HASHES")? "ON" : "OFF";
+    fout
+      << "\nif(NOT DEFINED CMAKE_INSTALL_RECORD_HASHES)\n"
+      << "  set(CMAKE_INSTALL_RECORD_HASHES " << recordHashes << ")\n"
+      << "endif()\n"
+      << "if(CMAKE_INSTALL_RECORD_HASHES)\n"
+      << "  execute_process(COMMAND \"${CMAKE_COMMAND}\" -E "
+      << "cmake_install_manifest_hashes\n"
+      << "    \"" << homedir << "/${CMAKE_INSTALL_MANIFEST}\"\n"
+      << "    \"" << homedir << "/${CMAKE_INSTALL_MANIFEST_HASHES}\"\n"
+      << "    RESULT_VARIABLE _install_hashes_result)\n"
+      << "  if(NOT _install_hashes_result EQUAL 0)\n"
+      << "    message(FATAL_ERROR \"Failed to write \\\""
+      << homedir << "/${CMAKE_INSTALL_MANIFEST_HASHES}\\\"\")\n"
+      << "  endif()\n"
+      << "endif()\n";
+
+    // Report how much content was linked when requested.
+    fout <<
+      "\n"
+      "if(DEFINED ENV{CMAKE_INSTALL_MODE})\n"
+      "  foreach(_kind COPIED LINKED)\n"
+      "    get_property(_bytes_${_kind} GLOBAL PROPERTY "
+      "INSTALL_BYTES_${_kind})\n"
+      "    if(NOT _bytes_${_kind})\n"
+      "      set(_bytes_${_kind} 0)\n"
+      "    endif()\n"
+      "  endforeach()\n"
+      "  message(STATUS \"Install bytes copied: ${_bytes_COPIED}, "
+      "linked: ${_bytes_LINKED}\")\n"
+      "endif()\n";
+    }
+}
+
+//----------------------------------------------------------------------------
+void cmLocalGenerator::GenerateDirectoryInstallRules(std::ostream& fout)
+{
+  // Compute the set of configurations.
+  std::vector<std::string> configurationTypes;
+  const std::string& config =
+    this->Makefile->GetConfigurations(configurationTypes, false);
+
+  // Copy user-specified install options to the install code.
+  if(const char* so_no_exe =
+     this->Makefile->GetDefinition("CMAKE_INSTALL_SO_NO_EXE"))
+    {
+    fout <<
+      "# Install shared libraries without execute permission?\n"
+      "if(NOT DEFINED CMAKE_INSTALL_SO_NO_EXE)\n"
+      "  set(CMAKE_INSTALL_SO_NO_EXE \"" << so_no_exe << "\")\n"
+      "endif()\n"
+      "\n";
+    }
+
+  // Ask each install generator to write its code.
+  std::vector<cmInstallGenerator*> const& installers =
+    this->Makefile->GetInstallGenerators();
+  for(std::vector<cmInstallGenerator*>::const_iterator
+        gi = installers.begin();
+      gi != installers.end(); ++gi)
+    {
+    (*gi)->Generate(fout, config, configurationTypes);
+    }
+
+  // Write rules from old-style specification stored in targets.
+  this->GenerateTargetInstallRules(fout, config, configurationTypes);
+}
+
+//----------------------------------------------------------------------------
+void cmLocalGenerator::GenerateSubdirectoryInstallRules(std::ostream& fout)
+{
+  // Write the rules in the order the included scripts would run them.
+  for(std::vector<cmLocalGenerator*>::const_iterator
+        ci = this->Children.begin(); ci != this->Children.end(); ++ci)
+    {
+    if(!(*ci)->GetMakefile()->GetPropertyAsBool("EXCLUDE_FROM_ALL"))
+      {
+      fout << "# Install rules for directory: "
+           << (*ci)->GetMakefile()->GetCurrentDirectory() << "\n\n";
+      (*ci)->GenerateDirectoryInstallRules(fout);
+      (*ci)->GenerateSubdirectoryInstallRules(fout);
+      }
     }
 }
 
@@ -420,6 +420,11 @@ protected:
   // to a custom target.
   void CreateCustomTargetsAndCommands(std::set<std::string> const&);
 
+  // Write the install rules of this directory without the script
+  // header, and optionally those of its subdirectories after them.
+  void GenerateDirectoryInstallRules(std::ostream& os);
+  void GenerateSubdirectoryInstallRules(std::ostream& os);
+
   // Handle old-style install rules stored in the targets.
   void GenerateTargetInstallRules(
     std::ostream& os, const std::string& config,
@@ -412,6 +412,9 @@ bool cmMakefile::ExecuteCommand(const cmListFileFunction& lff,
         {
         this->PrintCommandTrace(lff);
         }
+      // The previous command may have changed files on disk.
+      this->LocalGenerator->GetGlobalGenerator()->FileSystemMayHaveChanged();
+
       // Try invoking the command.
       if(!pcmd->InvokeInitialPass(lff.Arguments,status) ||
          status.GetNestedError())
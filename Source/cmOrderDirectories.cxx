@@ -126,15 +126,19 @@ protected:
 bool cmOrderDirectoriesConstraint::FileMayConflict(std::string const& dir,
                                                    std::string const& name)
 {
-  // Check if the file exists on disk.
-  std::string file = dir;
-  file += "/";
-  file += name;
-  if(cmSystemTools::FileExists(file.c_str(), true))
-    {
-    // The file conflicts only if it is not the same as the original
-    // file due to a symlink or hardlink.
-    return !cmSystemTools::SameFile(this->FullPath.c_str(), file.c_str());
+  // Check if the file exists on disk.  The cached directory listing
+  // avoids probing the disk for every candidate name.
+  if(this->GlobalGenerator->FileExistsInDirectory(dir, name))
+    {
+    std::string file = dir;
+    file += "/";
+    file += name;
+    if(cmSystemTools::FileExists(file.c_str(), true))
+      {
+      // The file conflicts only if it is not the same as the original
+      // file due to a symlink or hardlink.
+      return !cmSystemTools::SameFile(this->FullPath.c_str(), file.c_str());
+      }
     }
 
   // Check if the file will be built by cmake.
@@ -157,7 +161,7 @@ public:
       {
       // Try to guess the soname.
       std::string soguess;
-      if(cmSystemTools::GuessLibrarySOName(file, soguess))
+      if(this->GlobalGenerator->GuessLibrarySOName(file, soguess))
         {
         this->SOName = soguess;
         }
@@ -227,6 +231,23 @@ public:
                                       std::string const& file):
     cmOrderDirectoriesConstraint(od, file)
     {
+    // Compute the other names of the file the linker might consider.
+    // This is done once here rather than for every directory checked.
+    if(!this->OD->LinkExtensions.empty() &&
+       this->OD->RemoveLibraryExtension.find(this->FileName))
+      {
+      std::string lib = this->OD->RemoveLibraryExtension.match(1);
+      std::string ext = this->OD->RemoveLibraryExtension.match(2);
+      for(std::vector<std::string>::iterator
+            i = this->OD->LinkExtensions.begin();
+          i != this->OD->LinkExtensions.end(); ++i)
+        {
+        if(*i != ext)
+          {
+          this->OtherNames.push_back(lib + *i);
+          }
+        }
+      }
     }
 
   virtual void Report(std::ostream& e)
@@ -235,6 +256,9 @@ public:
     }
 
   virtual bool FindConflict(std::string const& dir);
+private:
+  // Names of the library with other extensions.
+  std::vector<std::string> OtherNames;
 };
 
 //----------------------------------------------------------------------------
@@ -248,24 +272,12 @@ bool cmOrderDirectoriesConstraintLibrary::FindConflict(std::string const& dir)
 
   // Now check if the file exists with other extensions the linker
   // might consider.
-  if(!this->OD->LinkExtensions.empty() &&
-     this->OD->RemoveLibraryExtension.find(this->FileName))
-    {
-    std::string lib = this->OD->RemoveLibraryExtension.match(1);
-    std::string ext = this->OD->RemoveLibraryExtension.match(2);
-    for(std::vector<std::string>::iterator
-          i = this->OD->LinkExtensions.begin();
-        i != this->OD->LinkExtensions.end(); ++i)
+  for(std::vector<std::string>::const_iterator
+        i = this->OtherNames.begin(); i != this->OtherNames.end(); ++i)
+    {
+    if(this->FileMayConflict(dir, *i))
       {
-      if(*i != ext)
-        {
-        std::string fname = lib;
-        fname += *i;
-        if(this->FileMayConflict(dir, fname))
-          {
-          return true;
-          }
-        }
+      return true;
       }
     }
   return false;
@@ -62,6 +62,12 @@
 #  include "cmCryptoHash.h"
 #endif
 
+#if defined(CMAKE_BUILD_WITH_CMAKE) && defined(__linux__)
+#  include <sys/ioctl.h>
+// Clone a file as with "cp --reflink".  Defined by <linux/fs.h>.
+#  define CM_FICLONE _IOW(0x94, 9, int)
+#endif
+
 #if defined(CMAKE_USE_ELF_PARSER)
 # include "cmELF.h"
 #endif
@@ -950,6 +956,47 @@ bool cmSystemTools::RenameFile(const char* oldname, const char* newname)
 #endif
 }
 
+//----------------------------------------------------------------------------
+bool cmSystemTools::CreateHardLink(const char* oldname, const char* newname)
+{
+#if defined(_WIN32) && !defined(__CYGWIN__)
+  return CreateHardLinkW(cmsys::Encoding::ToWide(newname).c_str(),
+                         cmsys::Encoding::ToWide(oldname).c_str(), 0) != 0;
+#else
+  return link(oldname, newname) == 0;
+#endif
+}
+
+//----------------------------------------------------------------------------
+bool cmSystemTools::CloneFile(const char* oldname, const char* newname)
+{
+#if defined(CMAKE_BUILD_WITH_CMAKE) && defined(__linux__)
+  int in = open(oldname, O_RDONLY);
+  if(in < 0)
+    {
+    return false;
+    }
+  int out = open(newname, O_WRONLY | O_CREAT | O_TRUNC, 0600);
+  if(out < 0)
+    {
+    close(in);
+    return false;
+    }
+  bool cloned = ioctl(out, CM_FICLONE, in) == 0;
+  close(out);
+  close(in);
+  if(!cloned)
+    {
+    unlink(newname);
+    }
+  return cloned;
+#else
+  (void)oldname;
+  (void)newname;
+  return false;
+#endif
+}
+
 bool cmSystemTools::ComputeFileMD5(const std::string& source, char* md5out)
 {
 #if defined(CMAKE_BUILD_WITH_CMAKE)
@@ -1451,7 +1498,8 @@ bool cmSystemTools::IsPathToFramework(const char* path)
 
 bool cmSystemTools::CreateTar(const char* outFileName,
                               const std::vector<std::string>& files,
-                              bool gzip, bool bzip2, bool verbose)
+                              bool gzip, bool bzip2, bool verbose,
+                              bool zstd, int threads)
 {
 #if defined(CMAKE_BUILD_WITH_CMAKE)
   std::string cwd = cmSystemTools::GetCurrentWorkingDirectory();
@@ -1467,8 +1515,9 @@ bool cmSystemTools::CreateTar(const char* outFileName,
     }
   cmArchiveWrite a(fout, (gzip? cmArchiveWrite::CompressGZip :
                           (bzip2? cmArchiveWrite::CompressBZip2 :
-                           cmArchiveWrite::CompressNone)),
-                           cmArchiveWrite::TypeTAR);
+                           (zstd? cmArchiveWrite::CompressZstd :
+                            cmArchiveWrite::CompressNone))),
+                           cmArchiveWrite::TypeTAR, 0, threads);
   a.SetVerbose(verbose);
   for(std::vector<std::string>::const_iterator i = files.begin();
       i != files.end(); ++i)
@@ -1494,7 +1543,10 @@ bool cmSystemTools::CreateTar(const char* outFileName,
   (void)outFileName;
   (void)files;
   (void)gzip;
+  (void)bzip2;
   (void)verbose;
+  (void)zstd;
+  (void)threads;
   return false;
 #endif
 }
@@ -1664,6 +1716,11 @@ bool extract_tar(const char* outFileName, bool verbose,
   struct archive* a = archive_read_new();
   struct archive *ext = archive_write_disk_new();
   archive_read_support_compression_all(a);
+  // The bundled libarchive has no zstd support.  Decompress zstd
+  // frames, recognized by their magic number, with the zstd tool.
+  static const char zstd_magic[] = "\x28\xb5\x2f\xfd";
+  archive_read_support_filter_program_signature(a, "zstd -d -q -c",
+                                                zstd_magic, 4);
   archive_read_support_format_all(a);
   struct archive_entry *entry;
   int r = cm_archive_read_open_file(a, outFileName, 10240);
@@ -188,6 +188,15 @@ public:
       if possible).  */
   static bool RenameFile(const char* oldname, const char* newname);
 
+  /** Create a hard link "newname" to the file "oldname".  Both names
+      must be on the same disk volume.  */
+  static bool CreateHardLink(const char* oldname, const char* newname);
+
+  /** Create "newname" as a copy-on-write clone of the file "oldname"
+      sharing its data on disk.  Returns false if the file system does
+      not support cloning.  */
+  static bool CloneFile(const char* oldname, const char* newname);
+
   ///! Compute the md5sum of a file
   static bool ComputeFileMD5(const std::string& source, char* md5out);
 
@@ -387,7 +396,8 @@ public:
                       bool gzip, bool verbose);
   static bool CreateTar(const char* outFileName,
                         const std::vector<std::string>& files, bool gzip,
-                        bool bzip2, bool verbose);
+                        bool bzip2, bool verbose, bool zstd = false,
+                        int threads = 1);
   static bool ExtractTar(const char* inFileName, bool gzip,
                          bool verbose);
   // This should be called first thing in main
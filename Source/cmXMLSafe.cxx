@@ -50,6 +50,19 @@ cmsys_stl::string cmXMLSafe::str()
   return ss.str();
 }
 
+//----------------------------------------------------------------------------
+// Whether a byte is written unchanged and needs no UTF-8 decoding.
+static bool cmXMLSafeIsPlain(char c, bool doQuotes)
+{
+  switch(c)
+    {
+    case '&': case '<': case '>': return false;
+    case '"': case '\'': return !doQuotes;
+    case '\t': case '\n': return true;
+    default: return c >= 0x20 && c < 0x7F;
+    }
+}
+
 //----------------------------------------------------------------------------
 cmsys_ios::ostream& operator<<(cmsys_ios::ostream& os, cmXMLSafe const& self)
 {
@@ -57,6 +70,19 @@ cmsys_ios::ostream& operator<<(cmsys_ios::ostream& os, cmXMLSafe const& self)
   char const* last = self.Data + self.Size;
   while(first != last)
     {
+    // Write a run of plain ASCII text with one call.
+    char const* plain = first;
+    while(plain != last && cmXMLSafeIsPlain(*plain, self.DoQuotes))
+      {
+      ++plain;
+      }
+    if(plain != first)
+      {
+      os.write(first, plain-first);
+      first = plain;
+      continue;
+      }
+
     unsigned int ch;
     if(const char* next = cm_utf8_decode_character(first, last, &ch))
       {
@@ -18,7 +18,9 @@
 
 #if defined(CMAKE_BUILD_WITH_CMAKE)
 # include "cmDependsFortran.h" // For -E cmake_copy_f90_mod callback.
+# include "cmCryptoHash.h" // For -E cmake_hash_files.
 # include <cmsys/Terminal.h>
+# include <cmsys/auto_ptr.hxx>
 #endif
 
 #include <cmsys/Directory.hxx>
@@ -71,12 +73,20 @@ void CMakeCommandUsage(const char* program)
     << "  remove_directory dir      - remove a directory and its contents\n"
     << "  rename oldname newname    - rename a file or directory "
        "(on one volume)\n"
-    << "  tar [cxt][vfz][cvfj] file.tar [file/dir1 file/dir2 ...]\n"
+    << "  tar [cxt][vfz][cvfj] file.tar [--zstd] [--threads=<n>] [--] "
+       "[file/dir1 file/dir2 ...]\n"
     << "                            - create or extract a tar or zip archive\n"
+    << "                              (--zstd compresses with zstd,\n"
+    << "                              --threads compresses with <n> threads,\n"
+    << "                              0 meaning all processors, and --\n"
+    << "                              treats all later arguments as files)\n"
     << "  sleep <number>...         - sleep for given number of seconds\n"
     << "  time command [args] ...   - run command and return elapsed time\n"
     << "  touch file                - touch a file.\n"
     << "  touch_nocreate file       - touch a file but do not create it.\n"
+    << "  verify_install_manifest file\n"
+    << "                            - check installed files against an\n"
+    << "                              install_manifest.hashes file\n"
 #if defined(_WIN32) && !defined(__CYGWIN__)
     << "Available on Windows only:\n"
     << "  delete_regv key           - delete registry value\n"
@@ -416,6 +426,25 @@ int cmcmd::ExecuteCMakeCommand(std::vector<std::string>& args)
       return retval;
       }
 
+#if defined(CMAKE_BUILD_WITH_CMAKE)
+    // Internal CMake file hashing used by file(HASHES).  Print one line
+    // per file with its hash, or an empty line if it cannot be read.
+    else if (args[1] == "cmake_hash_files" && args.size() >= 3)
+      {
+      cmsys::auto_ptr<cmCryptoHash> hash(cmCryptoHash::New(args[2].c_str()));
+      if(!hash.get())
+        {
+        std::cerr << "Unknown hash algorithm \"" << args[2] << "\"\n";
+        return 1;
+        }
+      for (std::string::size_type cc = 3; cc < args.size(); cc ++)
+        {
+        std::cout << hash->HashFile(args[cc]) << "\n";
+        }
+      return 0;
+      }
+#endif
+
     // Command to change directory and run a program.
     else if (args[1] == "chdir" && args.size() >= 4)
       {
@@ -689,6 +718,18 @@ int cmcmd::ExecuteCMakeCommand(std::vector<std::string>& args)
       return cmcmd::ExecuteLinkScript(args);
       }
 
+    // Internal CMake install manifest support.
+    else if (args[1] == "cmake_install_manifest_hashes" && args.size() == 4)
+      {
+      return cmcmd::WriteInstallManifestHashes(args);
+      }
+
+    // Command to check an install tree against its manifest.
+    else if (args[1] == "verify_install_manifest" && args.size() == 3)
+      {
+      return cmcmd::VerifyInstallManifest(args);
+      }
+
     // Internal CMake unimplemented feature notification.
     else if (args[1] == "cmake_unimplemented_variable")
       {
@@ -729,9 +770,35 @@ int cmcmd::ExecuteCMakeCommand(std::vector<std::string>& args)
       std::string flags = args[2];
       std::string outFile = args[3];
       std::vector<std::string> files;
+      bool zstd = false;
+      int threads = 1;
+      bool doingFiles = false;
       for (std::string::size_type cc = 4; cc < args.size(); cc ++)
         {
-        files.push_back(args[cc]);
+        if(!doingFiles && args[cc] == "--zstd")
+          {
+          zstd = true;
+          }
+        else if(!doingFiles && cmHasLiteralPrefix(args[cc], "--threads="))
+          {
+          std::string value = args[cc].substr(10);
+          if(value.empty() || value.size() > 4 ||
+             value.find_first_not_of("0123456789") != value.npos)
+            {
+            cmSystemTools::Error("tar --threads= requires a non-negative "
+                                 "number: ", args[cc].c_str());
+            return 1;
+            }
+          threads = atoi(value.c_str());
+          }
+        else if(!doingFiles && args[cc] == "--")
+          {
+          doingFiles = true;
+          }
+        else
+          {
+          files.push_back(args[cc]);
+          }
         }
       bool gzip = false;
       bool bzip2 = false;
@@ -760,7 +827,8 @@ int cmcmd::ExecuteCMakeCommand(std::vector<std::string>& args)
       else if ( flags.find_first_of('c') != flags.npos )
         {
         if ( !cmSystemTools::CreateTar(
-               outFile.c_str(), files, gzip, bzip2, verbose) )
+               outFile.c_str(), files, gzip, bzip2, verbose, zstd,
+               threads) )
           {
           cmSystemTools::Error("Problem creating tar: ", outFile.c_str());
           return 1;
@@ -897,6 +965,165 @@ bool cmcmd::SymlinkInternal(std::string const& file, std::string const& link)
 #endif
 }
 
+//----------------------------------------------------------------------------
+// One line of an install_manifest.hashes file:
+//   <md5> <size> <mtime> <file>
+// where <file> is the name recorded in install_manifest.txt and is
+// installed under the DESTDIR environment variable, if set.
+struct cmInstallManifestEntry
+{
+  std::string File;
+  std::string Hash;
+  unsigned long Size;
+  long MTime;
+};
+
+//----------------------------------------------------------------------------
+static bool cmInstallManifestRead(const char* fname,
+                                  std::vector<cmInstallManifestEntry>& entries)
+{
+  cmsys::ifstream fin(fname);
+  if(!fin)
+    {
+    return false;
+    }
+  std::string line;
+  while(cmSystemTools::GetLineFromStream(fin, line))
+    {
+    cmInstallManifestEntry e;
+    cmIStringStream in(line);
+    if(in >> e.Hash >> e.Size >> e.MTime && in.get() == ' ' &&
+       std::getline(in, e.File) && !e.File.empty())
+      {
+      entries.push_back(e);
+      }
+    }
+  return true;
+}
+
+//----------------------------------------------------------------------------
+static std::string cmInstallManifestPath(std::string const& file)
+{
+  const char* destdir = cmSystemTools::GetEnv("DESTDIR");
+  if(destdir && *destdir)
+    {
+    std::string path = destdir;
+    cmSystemTools::ConvertToUnixSlashes(path);
+    return path + file;
+    }
+  return file;
+}
+
+//----------------------------------------------------------------------------
+int cmcmd::WriteInstallManifestHashes(std::vector<std::string>& args)
+{
+  // args[2] = install_manifest.txt listing the installed files
+  // args[3] = install_manifest.hashes to update
+  std::string const& hashesFile = args[3];
+
+  // Reuse the hash of every file whose size and modification time
+  // have not changed since the previous installation.
+  std::vector<cmInstallManifestEntry> old;
+  cmInstallManifestRead(hashesFile.c_str(), old);
+  std::map<std::string, cmInstallManifestEntry const*> oldByFile;
+  for(std::vector<cmInstallManifestEntry>::const_iterator oi = old.begin();
+      oi != old.end(); ++oi)
+    {
+    oldByFile[oi->File] = &*oi;
+    }
+
+  cmsys::ifstream fin(args[2].c_str());
+  if(!fin)
+    {
+    std::cerr << "Cannot read install manifest \"" << args[2] << "\"\n";
+    return 1;
+    }
+  std::string tmpFile = hashesFile + ".tmp";
+  {
+  cmsys::ofstream fout(tmpFile.c_str());
+  if(!fout)
+    {
+    std::cerr << "Cannot write \"" << tmpFile << "\"\n";
+    return 1;
+    }
+  std::string file;
+  while(cmSystemTools::GetLineFromStream(fin, file))
+    {
+    std::string path = cmInstallManifestPath(file);
+    if(file.empty() || !cmSystemTools::FileExists(path.c_str(), true))
+      {
+      continue;
+      }
+    cmInstallManifestEntry e;
+    e.File = file;
+    e.Size = cmSystemTools::FileLength(path.c_str());
+    e.MTime = cmSystemTools::ModifiedTime(path.c_str());
+    std::map<std::string, cmInstallManifestEntry const*>::const_iterator
+      oi = oldByFile.find(file);
+    if(oi != oldByFile.end() &&
+       oi->second->Size == e.Size && oi->second->MTime == e.MTime)
+      {
+      e.Hash = oi->second->Hash;
+      }
+    else
+      {
+      char md5out[32];
+      if(!cmSystemTools::ComputeFileMD5(path.c_str(), md5out))
+        {
+        std::cerr << "Cannot compute MD5 of \"" << path << "\"\n";
+        continue;
+        }
+      e.Hash.assign(md5out, 32);
+      }
+    fout << e.Hash << " " << e.Size << " " << e.MTime << " "
+         << e.File << "\n";
+    }
+  }
+  return cmSystemTools::RenameFile(tmpFile.c_str(), hashesFile.c_str())?
+    0 : 1;
+}
+
+//----------------------------------------------------------------------------
+int cmcmd::VerifyInstallManifest(std::vector<std::string>& args)
+{
+  std::vector<cmInstallManifestEntry> entries;
+  if(!cmInstallManifestRead(args[2].c_str(), entries))
+    {
+    std::cerr << "Cannot read install manifest \"" << args[2] << "\"\n";
+    return 1;
+    }
+  int result = 0;
+  for(std::vector<cmInstallManifestEntry>::const_iterator
+        ei = entries.begin(); ei != entries.end(); ++ei)
+    {
+    std::string path = cmInstallManifestPath(ei->File);
+    char md5out[32];
+    const char* problem = 0;
+    if(!cmSystemTools::FileExists(path.c_str(), true))
+      {
+      problem = "missing";
+      }
+    else if(cmSystemTools::FileLength(path.c_str()) != ei->Size)
+      {
+      problem = "size differs";
+      }
+    else if(!cmSystemTools::ComputeFileMD5(path.c_str(), md5out))
+      {
+      problem = "cannot be read";
+      }
+    else if(ei->Hash != std::string(md5out, 32))
+      {
+      problem = "content differs";
+      }
+    if(problem)
+      {
+      std::cerr << path << ": " << problem << "\n";
+      result = 1;
+      }
+    }
+  return result;
+}
+
 //----------------------------------------------------------------------------
 #ifdef CMAKE_BUILD_WITH_CMAKE
 int cmcmd::ExecuteEchoColor(std::vector<std::string>& args)
@@ -74,6 +74,10 @@ static const char * cmDocumentationOptions[][2] =
   {"-A <file>, --add-notes <file>", "Add a notes file with submission"},
   {"-I [Start,End,Stride,test#,test#|Test file], --tests-information",
    "Run a specific number of tests by number."},
+  {"--shard <index>/<count>", "Run one of <count> cost-balanced parts of "
+   "the tests."},
+  {"--shard-cost-data <file>", "Balance test shards with the test costs "
+   "recorded in a file."},
   {"-U, --union", "Take the Union of -I and -R"},
   {"--rerun-failed", "Run only the tests that failed previously"},
   {"--max-width <width>", "Set the max width for a test name to output"},
@@ -101,6 +105,8 @@ static const char * cmDocumentationOptions[][2] =
   "when submitting dashboards."},
   {"--overwrite", "Overwrite CTest configuration option."},
   {"--extra-submit <file>[;<file>]", "Submit extra files to the dashboard."},
+  {"--merge-test-xml <output> <file>[;<file>]", "Merge Test.xml files "
+   "written by test shards."},
   {"--force-new-ctest-process", "Run child CTest instances as new processes"},
   {"--schedule-random", "Use a random order for scheduling tests"},
   {"--submit-index", "Submit individual dashboard tests with specific index"},
@@ -125,14 +131,16 @@ int main (int argc, char const* const* argv)
 
   cmSystemTools::DoNotInheritStdPipes();
   cmSystemTools::EnableMSVCDebugHook();
-  cmSystemTools::FindCMakeResources(argv[0]);
 
-  // Dispatch 'ctest --launch' mode directly.
+  // Dispatch 'ctest --launch' mode directly.  It runs once per build
+  // rule and needs no CMake resources, so do not look for them.
   if(argc >= 2 && strcmp(argv[1], "--launch") == 0)
     {
     return cmCTestLaunch::Main(argc, argv);
     }
 
+  cmSystemTools::FindCMakeResources(argv[0]);
+
   cmCTest inst;
 
   if ( cmSystemTools::GetCurrentWorkingDirectory().size() == 0 )
@@ -0,0 +1,289 @@
+/*============================================================================
+  CMake - Cross Platform Makefile Generator
+  Copyright 2000-2009 Kitware, Inc., Insight Software Consortium
+
+  Distributed under the OSI-approved BSD License (the "License");
+  see accompanying file Copyright.txt for details.
+
+  This software is distributed WITHOUT ANY WARRANTY; without even the
+  implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+  See the License for more information.
+============================================================================*/
+// Compare cmsys::RegularExpression with cmLinearRegularExpression on the
+// expressions that CMake and CTest actually use.  This is not run as a
+// test.  Build the benchLinearRegularExpression target and run
+//
+//   benchLinearRegularExpression <cmake-source-dir> [<build-log>]
+//
+// Each literal expression found in Modules/ and each default ctest_build
+// expression is matched against every line of the build log.  Without a
+// log, a synthetic compiler log is used.
+#include "cmLinearRegularExpression.h"
+#include "CTest/cmCTestRegexSet.h"
+#include "cmSystemTools.h"
+
+#include "cmStandardIncludes.h"
+
+#include <cmsys/Glob.hxx>
+#include <cmsys/FStream.hxx>
+#include <cmsys/RegularExpression.hxx>
+
+//----------------------------------------------------------------------------
+// Expand the escapes of a quoted CMake argument or C string literal.
+static std::string unescape(std::string const& in)
+{
+  std::string out;
+  for(std::string::size_type i = 0; i < in.size(); ++i)
+    {
+    if(in[i] != '\\' || i + 1 == in.size())
+      {
+      out += in[i];
+      continue;
+      }
+    switch(in[++i])
+      {
+      case 'n': out += '\n'; break;
+      case 'r': out += '\r'; break;
+      case 't': out += '\t'; break;
+      default: out += in[i]; break;
+      }
+    }
+  return out;
+}
+
+//----------------------------------------------------------------------------
+// Collect the quoted expressions given to if(MATCHES), string(REGEX) and
+// file(STRINGS REGEX) in Modules/, skipping those that use variables.
+static void readModuleRegexes(std::string const& source,
+                              std::vector<std::string>& regexes)
+{
+  cmsys::RegularExpression arg(
+    "(MATCHES|REGEX( MATCHALL| MATCH| REPLACE)?) +\"(([^\"\\\\]|\\\\.)*)\"");
+  cmsys::Glob gl;
+  gl.RecurseOn();
+  gl.FindFiles(source + "/Modules/*.cmake");
+  std::set<std::string> seen;
+  std::vector<std::string> const& files = gl.GetFiles();
+  for(std::vector<std::string>::const_iterator fi = files.begin();
+      fi != files.end(); ++fi)
+    {
+    cmsys::ifstream fin(fi->c_str());
+    std::string line;
+    while(cmSystemTools::GetLineFromStream(fin, line))
+      {
+      const char* s = line.c_str();
+      while(arg.find(s))
+        {
+        std::string regex = unescape(arg.match(3));
+        s += arg.end();
+        if(regex.empty() || regex.find('$') != regex.npos ||
+           regex.find('@') != regex.npos || !seen.insert(regex).second)
+          {
+          continue;
+          }
+        if(cmLinearRegularExpression(regex).is_valid())
+          {
+          regexes.push_back(regex);
+          }
+        }
+      }
+    }
+}
+
+//----------------------------------------------------------------------------
+// Collect the string literals of the default ctest_build error and warning
+// expressions and their exceptions.
+static void readCTestRegexes(std::string const& source,
+                             std::vector<std::string>& regexes)
+{
+  std::string file = source + "/Source/CTest/cmCTestBuildHandler.cxx";
+  cmsys::ifstream fin(file.c_str());
+  cmsys::RegularExpression begin(
+    "^static const char\\* cmCTest(Error|Warning)(Matches|Exceptions)");
+  cmsys::RegularExpression entry("^  \"(.*)\",$");
+  bool inside = false;
+  std::string line;
+  while(cmSystemTools::GetLineFromStream(fin, line))
+    {
+    if(begin.find(line))
+      {
+      inside = true;
+      }
+    else if(line == "  0")
+      {
+      inside = false;
+      }
+    else if(inside && entry.find(line))
+      {
+      regexes.push_back(unescape(entry.match(1)));
+      }
+    }
+}
+
+//----------------------------------------------------------------------------
+// Produce a log with the kinds of lines a build of CMake prints.
+static void makeLog(size_t count, std::vector<std::string>& lines)
+{
+  static const char* const templates[] = {
+    "[ %d%%] Building CXX object Source/CMakeFiles/CMakeLib.dir/cm%d.cxx.o",
+    "/usr/bin/c++ -O2 -DNDEBUG -I/home/user/build/Source"
+    " -o CMakeFiles/CMakeLib.dir/cm%d.cxx.o -c /home/user/src/cm%d.cxx",
+    "In file included from /home/user/src/Source/cm%d.h:%d:0,",
+    "                 from /home/user/src/Source/cm%d.cxx:%d:",
+    "/home/user/src/Source/cm%d.cxx:%d:7: warning: unused variable 'x'"
+    " [-Wunused-variable]",
+    "/home/user/src/Source/cm%d.cxx:%d:3: error: 'y' was not declared",
+    "make[2]: Leaving directory `/home/user/build/Source/%d/%d'",
+    "Linking CXX static library libCMakeLib%d%d.a",
+    0
+  };
+  size_t ntemplates = sizeof(templates) / sizeof(templates[0]) - 1;
+  char buffer[256];
+  for(size_t i = 0; i < count; ++i)
+    {
+    int n = static_cast<int>(i);
+    // Errors and warnings are rarer than other lines.
+    size_t t = (i * 7) % ntemplates;
+    if((t == 4 || t == 5) && i % 5 != 0)
+      {
+      t = 0;
+      }
+    sprintf(buffer, templates[t], n % 100, n);
+    lines.push_back(buffer);
+    }
+}
+
+//----------------------------------------------------------------------------
+// Match every expression against every line and return the time taken.
+template <class Regex>
+static double timeEngine(std::vector<std::string> const& regexes,
+                         std::vector<std::string> const& lines,
+                         size_t& matches)
+{
+  std::vector<Regex> compiled(regexes.size());
+  for(size_t r = 0; r < regexes.size(); ++r)
+    {
+    compiled[r].compile(regexes[r].c_str());
+    }
+  matches = 0;
+  double start = cmSystemTools::GetTime();
+  for(std::vector<std::string>::const_iterator li = lines.begin();
+      li != lines.end(); ++li)
+    {
+    for(typename std::vector<Regex>::iterator ri = compiled.begin();
+        ri != compiled.end(); ++ri)
+      {
+      if(ri->find(li->c_str()))
+        {
+        ++matches;
+        }
+      }
+    }
+  return cmSystemTools::GetTime() - start;
+}
+
+//----------------------------------------------------------------------------
+// Find the first matching expression of each line, as ctest_build does.
+static double timeRegexSet(std::vector<std::string> const& regexes,
+                           std::vector<std::string> const& lines,
+                           size_t& matches)
+{
+  cmCTestRegexSet set;
+  for(std::vector<std::string>::const_iterator ri = regexes.begin();
+      ri != regexes.end(); ++ri)
+    {
+    set.Add(*ri);
+    }
+  matches = 0;
+  double start = cmSystemTools::GetTime();
+  for(std::vector<std::string>::const_iterator li = lines.begin();
+      li != lines.end(); ++li)
+    {
+    if(set.Find(li->c_str()) >= 0)
+      {
+      ++matches;
+      }
+    }
+  return cmSystemTools::GetTime() - start;
+}
+
+//----------------------------------------------------------------------------
+static bool compare(const char* name, std::vector<std::string> const& regexes,
+                    std::vector<std::string> const& lines)
+{
+  size_t cmsysMatches = 0;
+  size_t linearMatches = 0;
+  double cmsysTime =
+    timeEngine<cmsys::RegularExpression>(regexes, lines, cmsysMatches);
+  double linearTime =
+    timeEngine<cmLinearRegularExpression>(regexes, lines, linearMatches);
+  printf("%s: %d expressions x %d lines\n", name,
+         static_cast<int>(regexes.size()), static_cast<int>(lines.size()));
+  printf("  cmsys  %8.3f s, %d matches\n", cmsysTime,
+         static_cast<int>(cmsysMatches));
+  printf("  linear %8.3f s, %d matches\n", linearTime,
+         static_cast<int>(linearMatches));
+  if(cmsysMatches != linearMatches)
+    {
+    printf("  the engines disagree\n");
+    return false;
+    }
+  return true;
+}
+
+//----------------------------------------------------------------------------
+int main(int argc, char* argv[])
+{
+  if(argc < 2)
+    {
+    fprintf(stderr,
+            "Usage: %s <cmake-source-dir> [<build-log>]\n", argv[0]);
+    return 1;
+    }
+  std::string source = argv[1];
+
+  std::vector<std::string> moduleRegexes;
+  readModuleRegexes(source, moduleRegexes);
+  std::vector<std::string> ctestRegexes;
+  readCTestRegexes(source, ctestRegexes);
+  if(moduleRegexes.empty() || ctestRegexes.empty())
+    {
+    fprintf(stderr, "No expressions found under %s\n", source.c_str());
+    return 1;
+    }
+
+  std::vector<std::string> moduleLines;
+  std::vector<std::string> ctestLines;
+  if(argc > 2)
+    {
+    cmsys::ifstream fin(argv[2]);
+    std::string line;
+    while(cmSystemTools::GetLineFromStream(fin, line))
+      {
+      moduleLines.push_back(line);
+      }
+    ctestLines = moduleLines;
+    }
+  else
+    {
+    makeLog(3000, moduleLines);
+    makeLog(20000, ctestLines);
+    }
+
+  int result = 0;
+  if(!compare("Modules/", moduleRegexes, moduleLines))
+    {
+    result = 1;
+    }
+  if(!compare("ctest_build", ctestRegexes, ctestLines))
+    {
+    result = 1;
+    }
+
+  size_t setMatches = 0;
+  double setTime = timeRegexSet(ctestRegexes, ctestLines, setMatches);
+  printf("ctest_build as a cmCTestRegexSet, first match per line\n");
+  printf("  linear %8.3f s, %d lines matched\n", setTime,
+         static_cast<int>(setMatches));
+  return result;
+}
@@ -0,0 +1,95 @@
+/*============================================================================
+  CMake - Cross Platform Makefile Generator
+  Copyright 2000-2009 Kitware, Inc., Insight Software Consortium
+
+  Distributed under the OSI-approved BSD License (the "License");
+  see accompanying file Copyright.txt for details.
+
+  This software is distributed WITHOUT ANY WARRANTY; without even the
+  implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+  See the License for more information.
+============================================================================*/
+#include "CTest/cmCTestRegexSet.h"
+
+#include "cmStandardIncludes.h"
+
+struct test_pair
+{
+  const char* in;
+  const char* out;
+};
+
+static test_pair const literals[] = {
+  {"^[Bb]us [Ee]rror", "bus error"},
+  {"([^ :]+):([0-9]+): warning:", ": warning:"},
+  {": \\*\\*\\* No rule", ": *** no rule"},
+  {"ab*cd", "cd"},
+  {"ab+cd", "ab"},
+  {"[^Ww]arning", "arning"},
+  {"(^|[ :])[Nn][Oo][Tt][Ee]", "note"},
+  {"error|warning", ""},
+  {"(error|warning): x", ": x"},
+  {0,0}
+};
+
+struct test_match
+{
+  const char* line;
+  int index;
+};
+
+static const char* const regexes[] = {
+  "^[Ee]rror",
+  ": warning",
+  "(fatal|internal) error",
+  "error|Error",
+  "[", // does not compile, never matches
+  0
+};
+
+static test_match const matches[] = {
+  {"Error: something", 0},
+  {"foo.c:3: warning: x", 1},
+  {"foo.c:3: internal error", 2},
+  {"an error occurred", 3},
+  {"an ERROR occurred", -1},
+  {"nothing to see here", -1},
+  {0,0}
+};
+
+int testCTestRegexSet(int, char*[])
+{
+  int result = 0;
+  for(test_pair const* p = literals; p->in; ++p)
+    {
+    std::string out = cmCTestRegexSet::RequiredLiteral(p->in);
+    if(out != p->out)
+      {
+      printf("literal of [%s]: expected [%s], got [%s]\n",
+             p->in, p->out, out.c_str());
+      result = 1;
+      }
+    }
+
+  cmCTestRegexSet set;
+  for(const char* const* r = regexes; *r; ++r)
+    {
+    set.Add(*r);
+    }
+  if(set.Size() != 5)
+    {
+    printf("expected 5 expressions, got %d\n", static_cast<int>(set.Size()));
+    result = 1;
+    }
+  for(test_match const* m = matches; m->line; ++m)
+    {
+    int index = set.Find(m->line);
+    if(index != m->index)
+      {
+      printf("line [%s]: expected match %d, got %d\n",
+             m->line, m->index, index);
+      result = 1;
+      }
+    }
+  return result;
+}
@@ -0,0 +1,365 @@
+/*============================================================================
+  CMake - Cross Platform Makefile Generator
+  Copyright 2000-2009 Kitware, Inc., Insight Software Consortium
+
+  Distributed under the OSI-approved BSD License (the "License");
+  see accompanying file Copyright.txt for details.
+
+  This software is distributed WITHOUT ANY WARRANTY; without even the
+  implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+  See the License for more information.
+============================================================================*/
+#include "cmLinearRegularExpression.h"
+
+#include "cmStandardIncludes.h"
+
+#include <cmsys/RegularExpression.hxx>
+
+static const char* const regexes[] = {
+  "abc",
+  "^abc$",
+  "a*b",
+  "(a|ab)(c|bcd)(d*)",
+  "(a+)(b?)(a*)",
+  "((a)|b)+",
+  "x(.*)y(.*)z",
+  "[^ :]+:[0-9]+: [Ww]arning",
+  "^[ \t]*#[ \t]*(include|import)[ \t]*[<\"]([^\">]+)([\">])",
+  "[]a-]+",
+  "[-a]+b",
+  "\\.\\*",
+  "$",
+  "^",
+  "(^|[ :])[Ee]rror",
+  "(a|b)*(a|b)*c",
+  "[a-c]?d+",
+  0
+};
+
+static const char* const strings[] = {
+  "",
+  "abc",
+  "xabcx",
+  "aaab",
+  "abcd",
+  "abcdd",
+  "aaba",
+  "abab",
+  "x1y2z3y4z",
+  "foo.c:12: warning: bar",
+  "foo.c:12: Warning",
+  "  # include <stdio.h>",
+  "#import \"a.h\"",
+  "]]-a-",
+  "--ab",
+  "a.*b",
+  "error here",
+  "an Error: there",
+  "ababbac",
+  "cddd",
+  0
+};
+
+// Inputs of the length at which the engine switches from the backtracker
+// to simulating all threads: a filler repeated up to a tail that holds
+// the interesting part, if any.  The fillers keep cmsys fast.
+struct ThresholdCase
+{
+  const char* Regex;
+  const char* Filler;
+  const char* Tail;
+};
+static const ThresholdCase thresholdCases[] = {
+  {"abc", "ab ", "xabcx"},
+  {"[^ :]+:[0-9]+: [Ww]arning", "a.c:1: note ", "foo.c:12: Warning"},
+  {"(^|[ :])[Ee]rror", "no rror ", "an Error: there"},
+  {"(a|ab)(c|bcd)(d*)", "ab ", "abcdd"},
+  {"(a+)(b?)(a*)", "b", "aaba"},
+  {"((a)|b)+", "c", "abab"},
+  {"[a-c]?d+", "ab ", "cddd"},
+  {"ba*", "a", "baa"},
+  {"a(a*)$", "a", ""},
+  {"[0-9]+x", "12 ", ""},
+  {0, 0, 0}
+};
+
+static bool testSame(const char* regex, const char* s)
+{
+  cmsys::RegularExpression a(regex);
+  cmLinearRegularExpression b(regex);
+  if(a.is_valid() != b.is_valid())
+    {
+    printf("[%s]: cmsys valid %d, linear valid %d\n", regex,
+           a.is_valid(), b.is_valid());
+    return false;
+    }
+  if(!a.is_valid())
+    {
+    return true;
+    }
+  bool fa = a.find(s);
+  bool fb = b.find(s);
+  if(fa != fb)
+    {
+    printf("[%s] on [%s]: cmsys %d, linear %d\n", regex, s, fa, fb);
+    return false;
+    }
+  for(int n = 0; fa && n < cmLinearRegularExpression::NSUBEXP; ++n)
+    {
+    if(a.match(n) != b.match(n) ||
+       (!a.match(n).empty() &&
+        (a.start(n) != b.start(n) || a.end(n) != b.end(n))))
+      {
+      printf("[%s] on [%s]: group %d is [%s] at %d, expected [%s] at %d\n",
+             regex, s, n, b.match(n).c_str(), static_cast<int>(b.start(n)),
+             a.match(n).c_str(), static_cast<int>(a.start(n)));
+      return false;
+      }
+    }
+  return true;
+}
+
+//----------------------------------------------------------------------------
+// Differential fuzzing against cmsys::RegularExpression.  Expressions are
+// generated over the characters "abc" and only in forms cmsys accepts:
+// an operand of * or + must consume a character, quantifiers do not
+// nest, and there are at most NSUBEXP-1 groups.
+static unsigned int fuzzState = 1;
+static unsigned int fuzzRand(unsigned int n)
+{
+  fuzzState = fuzzState * 1103515245u + 12345u;
+  return (fuzzState >> 16) % n;
+}
+
+static bool fuzzAlternation(std::string& out, int depth, int& groups,
+                            bool any);
+
+// Append a piece and return whether it always consumes a character.
+// With 'any', '.' and negated sets may appear.
+static bool fuzzPiece(std::string& out, int depth, int& groups, bool any)
+{
+  static const char* const sets[] = { "a", "b", "c", "a-b", "b-c" };
+  bool width = true;
+  switch(fuzzRand(any? 8 : 7))
+    {
+    case 0:
+    case 1:
+    case 2:
+      out += "abc"[fuzzRand(3)];
+      break;
+    case 3:
+      {
+      out += '[';
+      if(any && fuzzRand(3) == 0)
+        {
+        out += '^';
+        }
+      for(unsigned int n = 1 + fuzzRand(2); n > 0; --n)
+        {
+        out += sets[fuzzRand(5)];
+        }
+      out += ']';
+      }
+      break;
+    case 4:
+      if(depth > 0 && groups < cmLinearRegularExpression::NSUBEXP - 1)
+        {
+        ++groups;
+        out += '(';
+        width = fuzzAlternation(out, depth - 1, groups, any);
+        out += ')';
+        }
+      else
+        {
+        out += 'a';
+        }
+      break;
+    case 5:
+      out += fuzzRand(2)? '^' : '$';
+      return false;
+    case 6:
+      out += "\\.";
+      break;
+    default:
+      out += '.';
+      break;
+    }
+  switch(fuzzRand(6))
+    {
+    case 0:
+      out += '?';
+      width = false;
+      break;
+    case 1:
+      if(width)
+        {
+        out += '*';
+        width = false;
+        }
+      break;
+    case 2:
+      if(width)
+        {
+        out += '+';
+        }
+      break;
+    default:
+      break;
+    }
+  return width;
+}
+
+// Append an alternation and return whether every branch always consumes
+// a character.
+static bool fuzzAlternation(std::string& out, int depth, int& groups,
+                            bool any)
+{
+  bool width = true;
+  for(unsigned int b = 1 + (fuzzRand(4) == 0? 1 : 0); b > 0; --b)
+    {
+    bool branchWidth = false;
+    for(unsigned int p = 1 + fuzzRand(3); p > 0; --p)
+      {
+      bool pieceWidth = fuzzPiece(out, depth, groups, any);
+      branchWidth = branchWidth || pieceWidth;
+      }
+    width = width && branchWidth;
+    if(b > 1)
+      {
+      out += '|';
+      }
+    }
+  return width;
+}
+
+static std::string fuzzRegex(bool any)
+{
+  std::string regex;
+  int groups = 0;
+  fuzzAlternation(regex, 3, groups, any);
+  return regex;
+}
+
+static std::string fuzzString()
+{
+  std::string s;
+  for(unsigned int n = fuzzRand(12); n > 0; --n)
+    {
+    s += "abc."[fuzzRand(4)];
+    }
+  return s;
+}
+
+static bool testFuzz()
+{
+  bool result = true;
+
+  // Short inputs, searched by the backtracker.
+  for(int r = 0; r < 2000; ++r)
+    {
+    std::string regex = fuzzRegex(true);
+    for(int i = 0; i < 10; ++i)
+      {
+      if(!testSame(regex.c_str(), fuzzString().c_str()))
+        {
+        result = false;
+        }
+      }
+    }
+
+  // The same kind of input padded on the left to lengths on either side
+  // of the switch to simulating all threads.  Without '.' and negated
+  // sets no expression can match the padding, which keeps cmsys fast.
+  for(int r = 0; r < 200; ++r)
+    {
+    std::string regex = fuzzRegex(false);
+    cmLinearRegularExpression b(regex.c_str());
+    std::string::size_type limit = b.backtrack_limit();
+    std::string tail = fuzzString();
+    for(std::string::size_type len = limit; len <= limit + 1; ++len)
+      {
+      std::string s(len - tail.size(), 'z');
+      s += tail;
+      if(!testSame(regex.c_str(), s.c_str()))
+        {
+        result = false;
+        }
+      }
+    }
+  return result;
+}
+
+//----------------------------------------------------------------------------
+int testLinearRegularExpression(int, char*[])
+{
+  int result = 0;
+  for(const char* const* r = regexes; *r; ++r)
+    {
+    for(const char* const* s = strings; *s; ++s)
+      {
+      if(!testSame(*r, *s))
+        {
+        result = 1;
+        }
+      }
+    }
+
+  // Long input, matched by simulating all threads at once.
+  std::string longString(100000, 'a');
+  if(!testSame("ba*", (longString + "baa").c_str()) ||
+     !testSame("a(a*)$", longString.c_str()))
+    {
+    result = 1;
+    }
+
+  // Inputs at the longest length searched by the backtracker and one
+  // character longer.
+  for(const ThresholdCase* c = thresholdCases; c->Regex; ++c)
+    {
+    cmLinearRegularExpression b(c->Regex);
+    std::string tail = c->Tail;
+    for(std::string::size_type len = b.backtrack_limit();
+        len <= b.backtrack_limit() + 1; ++len)
+      {
+      std::string s;
+      while(s.size() + tail.size() < len)
+        {
+        s += c->Filler;
+        }
+      s.resize(len - tail.size());
+      s += tail;
+      if(!testSame(c->Regex, s.c_str()))
+        {
+        result = 1;
+        }
+      }
+    }
+
+  if(!testFuzz())
+    {
+    result = 1;
+    }
+
+  // Expressions that take exponential time to backtrack.  Test both short
+  // and long inputs.
+  cmLinearRegularExpression slow("(x+x+)+y");
+  if(slow.find(std::string(40, 'x')))
+    {
+    printf("(x+x+)+y should not match\n");
+    result = 1;
+    }
+  slow.compile("(a|aa)*b");
+  if(slow.find(longString))
+    {
+    printf("(a|aa)*b should not match\n");
+    result = 1;
+    }
+
+  cmLinearRegularExpression invalid;
+  if(invalid.compile("(a") || invalid.is_valid() || invalid.find("a"))
+    {
+    printf("(a should not compile\n");
+    result = 1;
+    }
+  return result;
+}
@@ -25,6 +25,9 @@ static test_pair const pairs[] = {
   {"angles <>", "angles &lt;&gt;"},
   {"ampersand &", "ampersand &amp;"},
   {"bad-byte \x80", "bad-byte [NON-UTF-8-BYTE-0x80]"},
+  {"quotes \"'", "quotes &quot;&apos;"},
+  {"tab\tline\r\nend", "tab\tline\nend"},
+  {"del \x7F<\xC2\xA9>", "del \x7F&lt;\xC2\xA9&gt;"},
   {0,0}
 };
 
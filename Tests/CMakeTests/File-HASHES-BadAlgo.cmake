@@ -0,0 +1 @@
+file(HASHES SHA3 hashes ${CMAKE_CURRENT_LIST_DIR}/File-HASH-Input.txt)
@@ -0,0 +1 @@
+file(HASHES MD5)
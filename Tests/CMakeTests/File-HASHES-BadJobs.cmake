@@ -0,0 +1 @@
+file(HASHES MD5 hashes JOBS 0x ${CMAKE_CURRENT_LIST_FILE})
@@ -0,0 +1,21 @@
+# Hash files of different sizes in more batches than jobs and compare
+# each hash in the list to the hash computed on its own.
+set(dir "${CMAKE_CURRENT_BINARY_DIR}/File-HASHES-Jobs")
+file(REMOVE_RECURSE "${dir}")
+set(content "0123456789abcdef")
+set(files)
+foreach(i RANGE 1 7)
+  set(content "${content}${content}")
+  file(WRITE "${dir}/${i}.txt" "${content}")
+  list(APPEND files "${dir}/${i}.txt"
+    "${CMAKE_CURRENT_LIST_DIR}/File-HASH-Input.txt")
+endforeach()
+file(HASHES SHA256 hashes JOBS 3 ${files})
+foreach(f ${files})
+  file(SHA256 "${f}" h)
+  list(APPEND expect "${h}")
+endforeach()
+if(NOT "${hashes}" STREQUAL "${expect}")
+  message(FATAL_ERROR "HASHES gave\n ${hashes}\nnot\n ${expect}")
+endif()
+message("HASHES-Jobs-ok")
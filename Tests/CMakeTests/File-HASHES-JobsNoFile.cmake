@@ -0,0 +1,4 @@
+file(HASHES MD5 hashes JOBS 2
+  ${CMAKE_CURRENT_LIST_FILE}
+  ${CMAKE_CURRENT_LIST_DIR}/DoesNotExist.txt
+  )
@@ -0,0 +1 @@
+file(HASHES MD5 hashes ${CMAKE_CURRENT_LIST_DIR}/DoesNotExist.txt)
@@ -0,0 +1,5 @@
+file(HASHES MD5 hashes
+  ${CMAKE_CURRENT_LIST_DIR}/File-HASH-Input.txt
+  ${CMAKE_CURRENT_LIST_DIR}/File-HASH-Input.txt
+  )
+message("${hashes}")
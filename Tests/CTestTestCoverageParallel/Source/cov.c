@@ -0,0 +1,3 @@
+int covered;
+int uncovered;
+/* not code */
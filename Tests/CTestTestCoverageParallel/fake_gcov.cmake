@@ -0,0 +1,25 @@
+# Stand-in for gcov, run as "cmake -P fake_gcov.cmake -o <dir> <n>.gcda".
+# Data file <n> covers the first line of cov.c <n> times.  Later data
+# files sleep less so that the jobs finish out of order.
+get_filename_component(n "${CMAKE_ARGV5}" NAME_WE)
+set(delays 1.5 1 0.5 0)
+math(EXPR i "${n} - 1")
+list(GET delays ${i} delay)
+execute_process(COMMAND ${CMAKE_COMMAND} -E sleep ${delay})
+
+file(APPEND "${CMAKE_ARGV4}/../../gcov-jobs.txt"
+  "${n} ${CMAKE_CURRENT_BINARY_DIR}\n")
+file(WRITE "${CMAKE_CURRENT_BINARY_DIR}/cov.c.gcov"
+"        -:    0:Source:cov.c
+        ${n}:    1:int covered;
+    #####:    2:int uncovered;
+        -:    3:/* not code */
+")
+
+# gcov reports on stdout.
+execute_process(COMMAND ${CMAKE_COMMAND} -E echo
+  "File '${CMAKE_CURRENT_LIST_DIR}/Source/cov.c'")
+execute_process(COMMAND ${CMAKE_COMMAND} -E echo
+  "Lines executed:50.00% of 2")
+execute_process(COMMAND ${CMAKE_COMMAND} -E echo
+  "Creating 'cov.c.gcov'")
@@ -0,0 +1,7 @@
+foreach(i RANGE 1 1000)
+  message(STATUS "line ${i} of chatty output")
+endforeach()
+message(STATUS "end of chatty output")
+if(FAIL)
+  message(FATAL_ERROR "chatty failure")
+endif()
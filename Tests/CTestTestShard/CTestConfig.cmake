@@ -0,0 +1,2 @@
+set(CTEST_PROJECT_NAME "CTestTestShard")
+set(CTEST_NIGHTLY_START_TIME "21:00:00 EDT")
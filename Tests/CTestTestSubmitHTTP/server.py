@@ -0,0 +1,90 @@
+# Stand-in for a CDash server that accepts http PUT submissions.
+#
+#   server.py <log> <command> [<args>...]
+#
+# Runs the command with CTEST_TEST_SUBMIT_PORT set to the port the server
+# listens on, and exits with its result.  Each PUT request waits a moment
+# before it is answered so that concurrent uploads overlap.  The first
+# upload of a file named "retry.txt" is answered with an error.  The log
+# records one line per request and the largest number of requests that
+# were in progress at the same time.
+
+import gzip
+import hashlib
+import io
+import os
+import subprocess
+import sys
+import threading
+import time
+
+try:
+    from http.server import BaseHTTPRequestHandler, HTTPServer
+    from socketserver import ThreadingMixIn
+    from urllib.parse import parse_qs, urlparse
+except ImportError:
+    from BaseHTTPServer import BaseHTTPRequestHandler, HTTPServer
+    from SocketServer import ThreadingMixIn
+    from urlparse import parse_qs, urlparse
+
+lock = threading.Lock()
+state = {'active': 0, 'max': 0, 'lines': [], 'failed': set()}
+
+
+def write_log():
+    with open(sys.argv[1], 'w') as f:
+        for line in state['lines']:
+            f.write(line + '\n')
+        f.write('max_active %d\n' % state['max'])
+
+
+class Handler(BaseHTTPRequestHandler):
+    protocol_version = 'HTTP/1.1'
+
+    def log_message(self, *args):
+        pass
+
+    def do_PUT(self):
+        query = parse_qs(urlparse(self.path).query)
+        name = query.get('FileName', [''])[0]
+        md5 = query.get('MD5', [''])[0]
+        body = self.rfile.read(int(self.headers.get('Content-Length', 0)))
+        encoding = self.headers.get('Content-Encoding', 'identity')
+        if encoding == 'gzip':
+            body = gzip.GzipFile(fileobj=io.BytesIO(body)).read()
+        with lock:
+            state['active'] += 1
+            state['max'] = max(state['max'], state['active'])
+        time.sleep(0.5)
+        with lock:
+            state['active'] -= 1
+            if name.endswith('retry.txt') and name not in state['failed']:
+                state['failed'].add(name)
+                status = 500
+            else:
+                status = 200
+            checksum = 'md5-ok' if hashlib.md5(body).hexdigest() == md5 \
+                else 'md5-bad'
+            state['lines'].append('%s %d %s %s' % (
+                os.path.basename(name), status, encoding, checksum))
+            write_log()
+        reply = b'OK\n'
+        self.send_response(status)
+        self.send_header('Content-Length', str(len(reply)))
+        self.end_headers()
+        self.wfile.write(reply)
+
+
+class Server(ThreadingMixIn, HTTPServer):
+    daemon_threads = True
+
+
+server = Server(('127.0.0.1', 0), Handler)
+thread = threading.Thread(target=server.serve_forever)
+thread.daemon = True
+thread.start()
+env = dict(os.environ)
+env['CTEST_TEST_SUBMIT_PORT'] = str(server.server_address[1])
+result = subprocess.call(sys.argv[2:], env=env)
+server.shutdown()
+sys.exit(result)
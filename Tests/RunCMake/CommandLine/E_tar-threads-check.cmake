@@ -0,0 +1,7 @@
+if(NOT EXISTS "${log}")
+  message(FATAL_ERROR "pigz was not run to compress the archive")
+endif()
+file(READ "${log}" args)
+if(NOT args STREQUAL "-c -q -p4\n")
+  message(FATAL_ERROR "pigz was run with unexpected arguments:\n ${args}")
+endif()
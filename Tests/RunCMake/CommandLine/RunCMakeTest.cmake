@@ -42,4 +42,74 @@ run_cmake_command(E_sleep-bad-arg1 ${CMAKE_COMMAND} -E sleep x)
 run_cmake_command(E_sleep-bad-arg2 ${CMAKE_COMMAND} -E sleep 1 -1)
 run_cmake_command(E_sleep-one-tenth ${CMAKE_COMMAND} -E sleep 0.1)
 
+find_program(ZSTD_EXECUTABLE NAMES zstd)
+if(ZSTD_EXECUTABLE)
+  # Use a single build tree for a few tests without cleaning.
+  set(RunCMake_TEST_BINARY_DIR ${RunCMake_BINARY_DIR}/E_tar-zstd-build)
+  set(RunCMake_TEST_NO_CLEAN 1)
+  file(REMOVE_RECURSE "${RunCMake_TEST_BINARY_DIR}")
+  file(WRITE "${RunCMake_TEST_BINARY_DIR}/content.txt" "zstd\n")
+  run_cmake_command(E_tar-zstd-create
+    ${CMAKE_COMMAND} -E tar cf archive.tar.zst --zstd content.txt
+    )
+  run_cmake_command(E_tar-zstd-list
+    ${CMAKE_COMMAND} -E tar tf archive.tar.zst
+    )
+  unset(RunCMake_TEST_BINARY_DIR)
+  unset(RunCMake_TEST_NO_CLEAN)
+endif()
+
+run_cmake_command(E_tar-threads-bad
+  ${CMAKE_COMMAND} -E tar cf archive.tar --threads=2x content.txt
+  )
+
+if(UNIX)
+  # Use a single build tree for a few tests without cleaning.
+  set(RunCMake_TEST_BINARY_DIR ${RunCMake_BINARY_DIR}/E_tar-threads-build)
+  set(RunCMake_TEST_NO_CLEAN 1)
+  file(REMOVE_RECURSE "${RunCMake_TEST_BINARY_DIR}")
+  file(WRITE "${RunCMake_TEST_BINARY_DIR}/content.txt" "threads\n")
+  # Stand in for pigz with a script that logs its arguments.
+  file(WRITE "${RunCMake_TEST_BINARY_DIR}/pigz"
+    "#!/bin/sh\necho \"$@\" > \"${RunCMake_TEST_BINARY_DIR}/pigz.log\"\n"
+    "exec gzip -c\n")
+  file(COPY "${RunCMake_TEST_BINARY_DIR}/pigz"
+    DESTINATION "${RunCMake_TEST_BINARY_DIR}/bin"
+    FILE_PERMISSIONS OWNER_READ OWNER_WRITE OWNER_EXECUTE)
+  run_cmake_command(E_tar-threads-create
+    ${CMAKE_COMMAND} -E env "PATH=${RunCMake_TEST_BINARY_DIR}/bin:$ENV{PATH}"
+    ${CMAKE_COMMAND} -E tar czf archive.tgz --threads=4 content.txt
+    )
+  run_cmake_command(E_tar-threads-list
+    ${CMAKE_COMMAND} -E tar tzf archive.tgz
+    )
+  run_cmake_command(E_tar-threads-check
+    ${CMAKE_COMMAND} -Dlog=${RunCMake_TEST_BINARY_DIR}/pigz.log
+    -P ${RunCMake_SOURCE_DIR}/E_tar-threads-check.cmake
+    )
+  unset(RunCMake_TEST_BINARY_DIR)
+  unset(RunCMake_TEST_NO_CLEAN)
+endif()
+
+# Use a single build tree for a few tests without cleaning.
+set(RunCMake_TEST_BINARY_DIR ${RunCMake_BINARY_DIR}/E_verify_install_manifest-build)
+set(RunCMake_TEST_NO_CLEAN 1)
+file(REMOVE_RECURSE "${RunCMake_TEST_BINARY_DIR}")
+file(WRITE "${RunCMake_TEST_BINARY_DIR}/content.txt" "installed\n")
+file(WRITE "${RunCMake_TEST_BINARY_DIR}/install_manifest.txt"
+  "${RunCMake_TEST_BINARY_DIR}/content.txt\n")
+run_cmake_command(E_verify_install_manifest-hashes
+  ${CMAKE_COMMAND} -E cmake_install_manifest_hashes
+  install_manifest.txt install_manifest.hashes
+  )
+run_cmake_command(E_verify_install_manifest-good
+  ${CMAKE_COMMAND} -E verify_install_manifest install_manifest.hashes
+  )
+file(WRITE "${RunCMake_TEST_BINARY_DIR}/content.txt" "INSTALLED\n")
+run_cmake_command(E_verify_install_manifest-bad
+  ${CMAKE_COMMAND} -E verify_install_manifest install_manifest.hashes
+  )
+unset(RunCMake_TEST_BINARY_DIR)
+unset(RunCMake_TEST_NO_CLEAN)
+
 run_cmake_command(P_directory ${CMAKE_COMMAND} -P ${RunCMake_SOURCE_DIR})
@@ -0,0 +1,4 @@
+set(CMAKE_DOWNLOAD_CACHE ${CMAKE_CURRENT_BINARY_DIR}/cache)
+file(DOWNLOAD file://${CMAKE_CURRENT_LIST_FILE}
+  ${CMAKE_CURRENT_BINARY_DIR}/downloaded.cmake
+  EXPECTED_HASH SHA1=../../escape)
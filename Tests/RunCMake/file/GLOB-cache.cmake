@@ -0,0 +1,32 @@
+set(dir ${CMAKE_CURRENT_BINARY_DIR}/GLOB-cache)
+file(REMOVE_RECURSE ${dir})
+file(WRITE ${dir}/a.txt "")
+file(WRITE ${dir}/sub/b.txt "")
+
+# Let the directory modification times age so the results are cached.
+execute_process(COMMAND ${CMAKE_COMMAND} -E sleep 1.5)
+
+file(GLOB_RECURSE first RELATIVE ${dir} ${dir}/*.txt)
+file(GLOB_RECURSE files RELATIVE ${dir} ${dir}/*.txt)
+if(NOT files STREQUAL "${first}")
+  message(FATAL_ERROR "GLOB_RECURSE repeated found:\n  ${files}\n"
+    "but first found:\n  ${first}")
+endif()
+list(SORT files)
+if(NOT files STREQUAL "a.txt;sub/b.txt")
+  message(FATAL_ERROR "GLOB_RECURSE found:\n  ${files}")
+endif()
+
+# A new file must be seen by a later identical search.
+file(WRITE ${dir}/sub/c.txt "")
+file(GLOB_RECURSE files RELATIVE ${dir} ${dir}/*.txt)
+list(SORT files)
+if(NOT files STREQUAL "a.txt;sub/b.txt;sub/c.txt")
+  message(FATAL_ERROR "GLOB_RECURSE after adding a file found:\n  ${files}")
+endif()
+
+file(REMOVE ${dir}/a.txt)
+file(GLOB files RELATIVE ${dir} ${dir}/*.txt)
+if(NOT files STREQUAL "")
+  message(FATAL_ERROR "GLOB after removing a file found:\n  ${files}")
+endif()
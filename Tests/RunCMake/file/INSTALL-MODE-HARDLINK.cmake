@@ -0,0 +1,42 @@
+set(src ${CMAKE_CURRENT_BINARY_DIR}/src)
+set(dst ${CMAKE_CURRENT_BINARY_DIR}/dst)
+set(cpy ${CMAKE_CURRENT_BINARY_DIR}/cpy)
+file(REMOVE_RECURSE ${src} ${dst} ${cpy})
+file(WRITE ${src}/file.txt "0123456789")
+file(WRITE ${src}/program.sh "#!/bin/sh\n")
+
+set(ENV{CMAKE_INSTALL_MODE} HARDLINK)
+file(INSTALL ${src}/file.txt DESTINATION ${dst} USE_SOURCE_PERMISSIONS)
+file(INSTALL ${src}/program.sh DESTINATION ${dst}
+  PERMISSIONS OWNER_READ OWNER_WRITE OWNER_EXECUTE)
+file(COPY ${src}/file.txt DESTINATION ${cpy})
+unset(ENV{CMAKE_INSTALL_MODE})
+
+file(READ ${dst}/file.txt content)
+if(NOT content STREQUAL "0123456789")
+  message(FATAL_ERROR "Installed file has content:\n  ${content}")
+endif()
+
+# The file with unchanged permissions is linked.  The program needs
+# new permissions and is copied or cloned.
+get_property(linked GLOBAL PROPERTY INSTALL_BYTES_LINKED)
+if(NOT linked EQUAL 10)
+  message(FATAL_ERROR "INSTALL_BYTES_LINKED is \"${linked}\", not 10")
+endif()
+
+# A hard link shares its content with the source, but a copy made by
+# file(COPY) does not.
+file(APPEND ${src}/file.txt "+")
+file(APPEND ${src}/program.sh "+")
+file(READ ${dst}/file.txt content)
+if(NOT content STREQUAL "0123456789+")
+  message(FATAL_ERROR "Installed file is not a hard link to its source")
+endif()
+file(READ ${dst}/program.sh content)
+if(NOT content STREQUAL "#!/bin/sh\n")
+  message(FATAL_ERROR "Installed program shares content with its source")
+endif()
+file(READ ${cpy}/file.txt content)
+if(NOT content STREQUAL "0123456789")
+  message(FATAL_ERROR "Copied file shares content with its source")
+endif()
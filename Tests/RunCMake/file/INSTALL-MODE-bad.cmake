@@ -0,0 +1,2 @@
+set(ENV{CMAKE_INSTALL_MODE} SYMLINK)
+file(INSTALL DESTINATION dir)
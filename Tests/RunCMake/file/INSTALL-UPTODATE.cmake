@@ -0,0 +1,19 @@
+set(src ${CMAKE_CURRENT_BINARY_DIR}/src)
+set(dst ${CMAKE_CURRENT_BINARY_DIR}/dst)
+file(REMOVE_RECURSE ${src} ${dst})
+file(WRITE ${src}/program.sh "#!/bin/sh\n")
+
+file(INSTALL ${src}/program.sh DESTINATION ${dst}
+  PERMISSIONS OWNER_READ OWNER_WRITE)
+
+# The second installation finds the file up to date but must still
+# apply the new permissions.
+file(INSTALL ${src}/program.sh DESTINATION ${dst}
+  PERMISSIONS OWNER_READ OWNER_WRITE OWNER_EXECUTE)
+
+if(UNIX)
+  execute_process(COMMAND test -x ${dst}/program.sh RESULT_VARIABLE res)
+  if(NOT res EQUAL 0)
+    message(FATAL_ERROR "Up-to-date file did not get new permissions.")
+  endif()
+endif()
@@ -2,4 +2,9 @@ include(RunCMake)
 
 run_cmake(INSTALL-DIRECTORY)
 run_cmake(INSTALL-MESSAGE-bad)
+run_cmake(INSTALL-MODE-HARDLINK)
+run_cmake(INSTALL-MODE-bad)
+run_cmake(INSTALL-UPTODATE)
+run_cmake(DOWNLOAD-hash-bad)
 run_cmake(FileOpenFailRead)
+run_cmake(GLOB-cache)
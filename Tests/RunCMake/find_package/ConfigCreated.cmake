@@ -0,0 +1,19 @@
+set(prefix "${CMAKE_CURRENT_BINARY_DIR}/prefix")
+file(REMOVE_RECURSE "${prefix}")
+file(MAKE_DIRECTORY "${prefix}/lib/cmake")
+
+# Nothing is installed in the prefix yet.
+find_package(ConfigCreated CONFIG QUIET PATHS "${prefix}" NO_DEFAULT_PATH)
+if(ConfigCreated_FOUND)
+  message(SEND_ERROR "ConfigCreated found before it was installed")
+endif()
+
+# Install the package during the configure step, as a superbuild does,
+# and look for it again.
+execute_process(COMMAND ${CMAKE_COMMAND} -E make_directory
+  "${prefix}/lib/cmake/ConfigCreated")
+file(WRITE "${prefix}/lib/cmake/ConfigCreated/ConfigCreatedConfig.cmake" "")
+find_package(ConfigCreated CONFIG QUIET PATHS "${prefix}" NO_DEFAULT_PATH)
+if(NOT ConfigCreated_FOUND)
+  message(SEND_ERROR "ConfigCreated not found after it was installed")
+endif()
@@ -14,3 +14,5 @@ run_cmake(MissingConfigRequired)
 run_cmake(MissingConfigVersion)
 run_cmake(MixedModeOptions)
 run_cmake(SetFoundFALSE)
+run_cmake(VersionFileCached)
+run_cmake(ConfigCreated)
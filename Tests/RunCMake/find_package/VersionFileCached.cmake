@@ -0,0 +1,40 @@
+macro(find_cached version expect)
+  unset(VersionFileCached_DIR CACHE)
+  find_package(VersionFileCached ${version} ${ARGN} CONFIG REQUIRED)
+  if(NOT VersionFileCached_VERSION STREQUAL "${expect}")
+    message(SEND_ERROR "VersionFileCached ${version} ${ARGN} found "
+      "\"${VersionFileCached_VERSION}\", not \"${expect}\"")
+  endif()
+endmacro()
+
+# The version file reads VersionFileCached_PROVIDED, which is not part
+# of the inputs a result is remembered for.  A remembered result is
+# reused for the same requested version.
+set(CMAKE_PREFIX_PATH "${CMAKE_CURRENT_SOURCE_DIR}/VersionFileCached")
+set(VersionFileCached_PROVIDED 1.2)
+find_cached(1.0 1.2)
+set(VersionFileCached_PROVIDED 1.3)
+find_cached(1.0 1.2)
+find_cached(1.1 1.3)
+
+# A cached result still honors the EXACT option.
+find_cached(1.3 1.3 EXACT)
+unset(VersionFileCached_DIR CACHE)
+find_package(VersionFileCached 1.0 EXACT CONFIG QUIET)
+if(VersionFileCached_FOUND)
+  message(SEND_ERROR "VersionFileCached 1.0 EXACT found")
+endif()
+
+# The result of a version file modified within the current second is
+# not remembered because a later change might not be noticed.
+set(dir "${CMAKE_CURRENT_BINARY_DIR}/Written")
+file(REMOVE_RECURSE "${dir}")
+file(COPY "${CMAKE_CURRENT_SOURCE_DIR}/VersionFileCached/cmake"
+  DESTINATION "${dir}")
+file(READ "${dir}/cmake/VersionFileCachedConfigVersion.cmake" content)
+file(WRITE "${dir}/cmake/VersionFileCachedConfigVersion.cmake" "${content}")
+set(CMAKE_PREFIX_PATH "${dir}")
+set(VersionFileCached_PROVIDED 2.0)
+find_cached(1.0 2.0)
+set(VersionFileCached_PROVIDED 2.1)
+find_cached(1.0 2.1)
@@ -0,0 +1,22 @@
+set(top ${RunCMake_TEST_BINARY_DIR}/cmake_install.cmake)
+file(READ ${top} script)
+if(script MATCHES "include\\([^)]*FlattenScripts/cmake_install.cmake")
+  set(RunCMake_TEST_FAILED
+    "${RunCMake_TEST_FAILED}Top-level script includes the subdirectory script.\n")
+endif()
+if(NOT EXISTS ${RunCMake_TEST_BINARY_DIR}/FlattenScripts/cmake_install.cmake)
+  set(RunCMake_TEST_FAILED
+    "${RunCMake_TEST_FAILED}Subdirectory script was not generated.\n")
+endif()
+execute_process(COMMAND ${CMAKE_COMMAND} -P ${top}
+  OUTPUT_VARIABLE out ERROR_VARIABLE err)
+set(expect "
+-- Install top\r?
+-- Install sub\r?
+-- Installing: [^\n]*/prefix/dir/empty.txt\r?
+")
+if(NOT out MATCHES "${expect}")
+  string(REGEX REPLACE "\n" "\n  " out "  ${out}")
+  set(RunCMake_TEST_FAILED
+    "${RunCMake_TEST_FAILED}Install did not run the subdirectory rules:\n${out}")
+endif()
@@ -0,0 +1,4 @@
+set(CMAKE_INSTALL_FLATTEN_SCRIPTS 1)
+set(CMAKE_INSTALL_PREFIX "${CMAKE_BINARY_DIR}/prefix")
+install(CODE "message(STATUS \"Install top\")")
+add_subdirectory(FlattenScripts)